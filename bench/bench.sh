@@ -0,0 +1,84 @@
+#!/bin/bash
+# Benchmark suite (make bench): for every workload made by bench/gen_data
+# (distribution x key type x number of records), runs every program on it
+# and reports records/s, MB/s and peak RSS (bench/measure), plus the
+# relative error of hll against the exact count of --count-distinct.
+#
+# Settings (environment variables):
+# BENCH_SIZES: numbers of records (default "1000 100000 1000000"; up to
+#              1000000000, which needs ~11 GB of disk in BENCH_DIR)
+# BENCH_DISTS: distributions (default "uniform zipf adversarial")
+# BENCH_TYPES: key types (default "int string")
+# BENCH_ADVERSARIAL_MAX: most distinct keys of an adversarial workload
+#              (default 4096; string keys all collide in hash --hash djb2,
+#              which is quadratic)
+# BENCH_DIR: where the generated inputs go (default: a temporary directory)
+# Distinct keys = records / 4. Run from the repository root.
+
+SIZES=${BENCH_SIZES:-1000 100000 1000000}
+DISTS=${BENCH_DISTS:-uniform zipf adversarial}
+TYPES=${BENCH_TYPES:-int string}
+ADVERSARIAL_MAX=${BENCH_ADVERSARIAL_MAX:-4096}
+
+if [ -n "$BENCH_DIR" ]; then
+  DIR=$BENCH_DIR
+  mkdir -p "$DIR"
+else
+  DIR=$(mktemp -d)
+  trap 'rm -rf "$DIR"' EXIT
+fi
+INPUT=$DIR/input.txt
+OUTPUT=$DIR/output.txt
+
+# Programs for every key type; the first one gives the exact distinct count
+INT_PROGRAMS=("./freq --count-distinct" "./freq" "./freq --engine radix"
+              "./hll -")
+STRING_PROGRAMS=("./hash --count-distinct" "./hash" "./hash --engine swiss"
+                 "./hash --hash djb2" "./hash --top 10"
+                 "./hll --keys string -")
+
+printf "%-12s %-7s %11s %9s  %-24s %12s %9s %10s %9s\n" distribution keys \
+       records distinct program "records/s" "MB/s" "peak RSS" "hll err"
+
+for dist in $DISTS; do
+  for type in $TYPES; do
+    for records in $SIZES; do
+      distinct=$((records / 4 > 0 ? records / 4 : 1))
+      if [ "$dist" = adversarial ] && [ "$distinct" -gt "$ADVERSARIAL_MAX" ]; then
+        distinct=$ADVERSARIAL_MAX
+      fi
+
+      bench/gen_data --dist "$dist" --type "$type" --records "$records" \
+                     --distinct "$distinct" > "$INPUT" || exit 1
+      bytes=$(stat -c %s "$INPUT")
+
+      if [ "$type" = int ]; then
+        programs=("${INT_PROGRAMS[@]}")
+      else
+        programs=("${STRING_PROGRAMS[@]}")
+      fi
+
+      exact=
+      for program in "${programs[@]}"; do
+        # shellcheck disable=SC2086
+        read -r seconds rss < <(bench/measure "$INPUT" "$OUTPUT" $program)
+
+        error=-
+        if [ -z "$exact" ]; then
+          exact=$(cat "$OUTPUT")
+        elif [[ $program == ./hll* ]]; then
+          error=$(awk -v e="$(cat "$OUTPUT")" -v x="$exact" \
+                  'BEGIN { printf "%+.2f%%", 100 * (e - x) / x }')
+        fi
+
+        awk -v d="$dist" -v t="$type" -v n="$records" -v k="$exact" \
+            -v p="$program" -v s="$seconds" -v b="$bytes" -v r="$rss" \
+            -v e="$error" 'BEGIN {
+              if (s < 0.001) s = 0.001
+              printf "%-12s %-7s %11d %9d  %-24s %12.0f %9.1f %7.1f MB %9s\n",
+                     d, t, n, k, p, n / s, b / s / 1048576, r / 1024, e
+            }'
+      done
+    done
+  done
+done
@@ -0,0 +1,32 @@
+#!/bin/bash
+# Times freq on a fully dense input: every value in [0, RANGE) appears
+# REPEAT times, in random order, so the output has RANGE lines and printing
+# it costs as much as reading the input.
+#
+# Usage: bench/freq_bench.sh [RANGE] [REPEAT] [binary...]
+# (binaries default to ./freq; run from the repository root)
+
+RANGE=${1:-2000000}
+REPEAT=${2:-2}
+shift $(( $# < 2 ? $# : 2 ))
+BINS=("$@")
+[ ${#BINS[@]} -eq 0 ] && BINS=(./freq)
+
+INPUT=$(mktemp)
+OUTPUT=$(mktemp)
+trap 'rm -f "$INPUT" "$OUTPUT"' EXIT
+
+for r in $(seq "$REPEAT"); do
+  seq 0 $((RANGE - 1))
+done | shuf --random-source=<(yes) > "$INPUT"
+
+echo "input: $(wc -l < "$INPUT") values, $RANGE distinct"
+
+TIMEFORMAT='%R s'
+for bin in "${BINS[@]}"; do
+  echo -n "$bin: "
+  # Best of 3 runs, writing to a real file
+  for run in 1 2 3; do
+    { time "$bin" < "$INPUT" > "$OUTPUT"; } 2>&1
+  done | sort -n | head -1
+done
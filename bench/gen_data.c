@@ -0,0 +1,294 @@
+// Copyright 2020 Radu-Stefan Minea 314CA
+
+/*
+ * Deterministic workload generator for freq, hash and hll: prints RECORDS
+ * keys, one per line, drawn from DISTINCT possible keys. The same options
+ * (and seed) always give the same output.
+ *
+ * Distributions:
+ * uniform: every key is equally likely
+ * zipf: the k-th most frequent key is proportional to 1 / k^s (--zipf-s)
+ * adversarial: keys made to collide, on purpose, in the hashtables of the
+ * repository: int keys all have the same low 32 bits of hash_u64 (hll's
+ * registers; freq's tables mix in a per-process seed first, so they aren't
+ * affected), string keys all have the same djb2 hash (hash --hash djb2);
+ * wyhash isn't affected
+ *
+ * Usage: bench/gen_data [--dist uniform|zipf|adversarial] [--type int|string]
+ *                       [--records N] [--distinct D] [--seed S]
+ *                       [--zipf-s X] [--all-keys]
+ * --all-keys: the first D records are the D keys, each once (so the output
+ * has exactly D distinct keys, when N >= D)
+ * (defaults: uniform int, N = 1000000, D = N / 4, S = 1, X = 1.0)
+ */
+
+#include <inttypes.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "libs/hashing.h"
+#include "libs/utils.h"
+#include "libs/writer.h"
+
+enum distribution { DIST_UNIFORM, DIST_ZIPF, DIST_ADVERSARIAL };
+enum key_type { KEY_INT, KEY_STRING };
+
+// Int keys stay non-negative 31-bit numbers (like the hll tests)
+#define INT_BITS 31
+#define INT_MASK ((UINT64_C(1) << INT_BITS) - 1)
+#define BASE62_DIGITS 11
+// Two djb2 blocks with the same hash: 'a' * 33 + 'c' == 'b' * 33 + 'B'
+#define DJB2_BLOCK_A "ac"
+#define DJB2_BLOCK_B "bB"
+#define DJB2_BLOCK_LEN 2
+
+/*
+ * Zipf sampler by rejection-inversion, O(1) memory for any number of keys.
+ * Credits: W. Hormann, G. Derflinger, "Rejection-inversion to generate
+ * variates from monotone discrete distributions" (1996)
+ */
+typedef struct zipf_sampler {
+  double s;
+  double n;
+  double h_integral_x1;
+  double h_integral_n;
+  double threshold;
+} zipf_sampler;
+
+/*
+ * Credits: splitmix64, Sebastiano Vigna
+ */
+static uint64_t next_random(uint64_t *state) {
+  uint64_t z = (*state += 0x9e3779b97f4a7c15ull);
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+  return z ^ (z >> 31);
+}
+
+// Uniform in [0, 1)
+static double next_double(uint64_t *state) {
+  return (next_random(state) >> 11) * (1.0 / (UINT64_C(1) << 53));
+}
+
+// log1p(x) / x and expm1(x) / x, without the loss of precision near 0
+static double helper1(double x) {
+  if (fabs(x) > 1e-8) {
+    return log1p(x) / x;
+  }
+  return 1 - x * (0.5 - x * (1.0 / 3 - 0.25 * x));
+}
+
+static double helper2(double x) {
+  if (fabs(x) > 1e-8) {
+    return expm1(x) / x;
+  }
+  return 1 + x * 0.5 * (1 + x / 3 * (1 + 0.25 * x));
+}
+
+static double zipf_h(const zipf_sampler *z, double x) {
+  return exp(-z->s * log(x));
+}
+
+static double zipf_h_integral(const zipf_sampler *z, double x) {
+  double log_x = log(x);
+  return helper2((1 - z->s) * log_x) * log_x;
+}
+
+static double zipf_h_integral_inverse(const zipf_sampler *z, double x) {
+  double t = x * (1 - z->s);
+  if (t < -1) {
+    t = -1;
+  }
+  return exp(helper1(t) * x);
+}
+
+static void init_zipf(zipf_sampler *z, double s, uint64_t n) {
+  z->s = s;
+  z->n = n;
+  z->h_integral_x1 = zipf_h_integral(z, 1.5) - 1;
+  z->h_integral_n = zipf_h_integral(z, n + 0.5);
+  z->threshold = 2 - zipf_h_integral_inverse(z, zipf_h_integral(z, 2.5) -
+                                                 zipf_h(z, 2));
+}
+
+// Rank in [0, n): 0 is the most frequent
+static uint64_t next_zipf(const zipf_sampler *z, uint64_t *state) {
+  for (;;) {
+    double u = z->h_integral_n +
+               next_double(state) * (z->h_integral_x1 - z->h_integral_n);
+    double x = zipf_h_integral_inverse(z, u);
+    double k = floor(x + 0.5);
+    if (k < 1) {
+      k = 1;
+    } else if (k > z->n) {
+      k = z->n;
+    }
+
+    if (k - x <= z->threshold ||
+        u >= zipf_h_integral(z, k + 0.5) - zipf_h(z, k)) {
+      return (uint64_t)k - 1;
+    }
+  }
+}
+
+// Bijection of [0, 2^31): spreads consecutive ids over the whole range
+static uint64_t scramble31(uint64_t x, uint64_t seed) {
+  x = (x + seed) & INT_MASK;
+  x = (x * 0x2545f491) & INT_MASK;
+  x ^= x >> 15;
+  x = (x * 0x5bd1e995) & INT_MASK;
+  x ^= x >> 13;
+  return x;
+}
+
+// Multiplicative inverse of an odd number, mod 2^64 (Newton's method)
+static uint64_t inverse_u64(uint64_t a) {
+  uint64_t x = a;
+  for (int i = 0; i < 5; i++) {
+    x *= 2 - a * x;
+  }
+  return x;
+}
+
+// The x for which hash_u64(x) == h
+static uint64_t unhash_u64(uint64_t h) {
+  h ^= h >> 33;
+  h *= inverse_u64(0xc4ceb9fe1a85ec53ull);
+  h ^= h >> 33;
+  h *= inverse_u64(0xff51afd7ed558ccdull);
+  h ^= h >> 33;
+  return h;
+}
+
+static void write_key(Writer *out, int dist, int type, uint64_t id,
+                      uint64_t seed, int adversarial_blocks) {
+  if (type == KEY_INT) {
+    if (dist == DIST_ADVERSARIAL) {
+      write_i64(out, (int64_t)unhash_u64(id << 32));
+    } else {
+      write_u64(out, scramble31(id, seed));
+    }
+    write_char(out, '\n');
+    return;
+  }
+
+  if (dist == DIST_ADVERSARIAL) {
+    for (int i = 0; i < adversarial_blocks; i++) {
+      write_bytes(out, (id >> i) & 1 ? DJB2_BLOCK_B : DJB2_BLOCK_A,
+                  DJB2_BLOCK_LEN);
+    }
+    write_char(out, '\n');
+    return;
+  }
+
+  static const char digits[] =
+      "0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ";
+  uint64_t x = hash_u64(id + seed);
+  char text[BASE62_DIGITS];
+  for (int i = 0; i < BASE62_DIGITS; i++) {
+    text[i] = digits[x % 62];
+    x /= 62;
+  }
+  write_bytes(out, text, BASE62_DIGITS);
+  write_char(out, '\n');
+}
+
+static void usage(const char *name) {
+  fprintf(stderr,
+          "Usage: %s [--dist uniform|zipf|adversarial] [--type int|string] "
+          "[--records N] [--distinct D] [--seed S] [--zipf-s X] "
+          "[--all-keys]\n",
+          name);
+  exit(ERROR_STATUS);
+}
+
+int main(int argc, char **argv) {
+  int dist = DIST_UNIFORM;
+  int type = KEY_INT;
+  uint64_t records = 1000000;
+  uint64_t distinct = 0;
+  uint64_t seed = 1;
+  double zipf_s = 1.0;
+  int all_keys = 0;
+
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "--dist") && i + 1 < argc) {
+      i++;
+      if (!strcmp(argv[i], "uniform")) {
+        dist = DIST_UNIFORM;
+      } else if (!strcmp(argv[i], "zipf")) {
+        dist = DIST_ZIPF;
+      } else if (!strcmp(argv[i], "adversarial")) {
+        dist = DIST_ADVERSARIAL;
+      } else {
+        usage(argv[0]);
+      }
+    } else if (!strcmp(argv[i], "--type") && i + 1 < argc) {
+      i++;
+      if (!strcmp(argv[i], "int")) {
+        type = KEY_INT;
+      } else if (!strcmp(argv[i], "string")) {
+        type = KEY_STRING;
+      } else {
+        usage(argv[0]);
+      }
+    } else if (!strcmp(argv[i], "--records") && i + 1 < argc) {
+      records = strtoull(argv[++i], NULL, 10);
+    } else if (!strcmp(argv[i], "--distinct") && i + 1 < argc) {
+      distinct = strtoull(argv[++i], NULL, 10);
+    } else if (!strcmp(argv[i], "--seed") && i + 1 < argc) {
+      seed = strtoull(argv[++i], NULL, 10);
+    } else if (!strcmp(argv[i], "--zipf-s") && i + 1 < argc) {
+      zipf_s = atof(argv[++i]);
+    } else if (!strcmp(argv[i], "--all-keys")) {
+      all_keys = 1;
+    } else {
+      usage(argv[0]);
+    }
+  }
+
+  if (distinct == 0) {
+    distinct = records / 4 ? records / 4 : 1;
+  }
+  // Int ids have to fit the 31-bit (or, adversarial, 32-bit) bijection
+  if (type == KEY_INT && distinct > (UINT64_C(1) << INT_BITS)) {
+    fprintf(stderr, "At most 2^%d distinct int keys\n", INT_BITS);
+    exit(ERROR_STATUS);
+  }
+  if (zipf_s <= 0) {
+    fprintf(stderr, "--zipf-s must be positive\n");
+    exit(ERROR_STATUS);
+  }
+
+  // Enough djb2 blocks for every id to get its own string
+  int adversarial_blocks = 1;
+  while (adversarial_blocks < 64 &&
+         (UINT64_C(1) << adversarial_blocks) < distinct) {
+    adversarial_blocks++;
+  }
+
+  zipf_sampler zipf;
+  init_zipf(&zipf, zipf_s, distinct);
+
+  uint64_t state = seed;
+  uint64_t key_seed = next_random(&state);
+  Writer *out = open_writer(STDOUT_FILENO);
+
+  for (uint64_t i = 0; i < records; i++) {
+    uint64_t id;
+    if (all_keys && i < distinct) {
+      id = i;
+    } else if (dist == DIST_ZIPF) {
+      id = next_zipf(&zipf, &state);
+    } else {
+      id = next_random(&state) % distinct;
+    }
+    write_key(out, dist, type, id, key_seed, adversarial_blocks);
+  }
+
+  close_writer(out);
+  return 0;
+}
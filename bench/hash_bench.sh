@@ -0,0 +1,34 @@
+#!/bin/bash
+# Times hash on the tests_hash inputs, scaled up: every input line is
+# repeated SCALE times, with one of DISTINCT suffixes appended to it.
+#
+# Usage: bench/hash_bench.sh [SCALE] [DISTINCT] [binary...]
+# (binaries default to ./hash; run from the repository root)
+
+SCALE=${1:-20000}
+DISTINCT=${2:-4000}
+shift $(( $# < 2 ? $# : 2 ))
+BINS=("$@")
+[ ${#BINS[@]} -eq 0 ] && BINS=(./hash)
+
+INPUT=$(mktemp)
+trap 'rm -f "$INPUT"' EXIT
+
+cat tests_hash/test*.txt | awk -v scale="$SCALE" -v distinct="$DISTINCT" '
+  { lines[NR] = $0 }
+  END {
+    for (r = 0; r < scale; r++)
+      for (i = 1; i <= NR; i++)
+        print lines[i] "_" (r % distinct)
+  }' > "$INPUT"
+
+echo "input: $(wc -l < "$INPUT") lines, $(sort -u "$INPUT" | wc -l) distinct"
+
+TIMEFORMAT='%R s'
+for bin in "${BINS[@]}"; do
+  echo -n "$bin: "
+  # Best of 3 runs
+  for run in 1 2 3; do
+    { time "$bin" < "$INPUT" > /dev/null; } 2>&1
+  done | sort -n | head -1
+done
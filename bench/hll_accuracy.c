@@ -0,0 +1,103 @@
+// Copyright 2020 Radu-Stefan Minea 314CA
+
+/*
+ * Accuracy of the hll estimators: inserts distinct values 1, 2, 3, ... into
+ * a sketch and, at cardinalities 1, 2, 5, 10, 20, 50, ..., prints the mean
+ * and the root mean square of the relative error of every estimator, over
+ * RUNS sketches (each with its own values).
+ *
+ * Usage: bench/hll_accuracy [MAX_CARDINALITY] [PRECISION] [RUNS]
+ * (defaults: 1000000000 14 1; make hll_accuracy builds it)
+ */
+
+#include <inttypes.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "libs/hashing.h"
+#include "libs/hll_estimate.h"
+#include "libs/hll_sketch.h"
+#include "libs/utils.h"
+
+#define MAX_CHECKPOINTS 64
+#define NO_ESTIMATORS 3
+// Values of different runs never overlap below 2^40 per run
+#define RUN_SHIFT 40
+
+static const char *estimator_names[NO_ESTIMATORS] = { "raw", "hllpp", "ertl" };
+
+int main(int argc, char **argv) {
+  uint64_t max_n = argc > 1 ? strtoull(argv[1], NULL, 10) : 1000000000;
+  int precision = argc > 2 ? atoi(argv[2]) : 14;
+  int runs = argc > 3 ? atoi(argv[3]) : 1;
+
+  if (precision < HLL_MIN_PRECISION || precision > HLL_MAX_PRECISION ||
+      runs < 1 || max_n < 1) {
+    fprintf(stderr,
+            "Usage: %s [MAX_CARDINALITY] [PRECISION (%d..%d)] [RUNS]\n",
+            argv[0], HLL_MIN_PRECISION, HLL_MAX_PRECISION);
+    exit(ERROR_STATUS);
+  }
+
+  // 1, 2, 5, 10, 20, 50, ... up to max_n
+  uint64_t checkpoints[MAX_CHECKPOINTS];
+  int no_checkpoints = 0;
+  for (uint64_t scale = 1; no_checkpoints < MAX_CHECKPOINTS - 3;
+       scale *= 10) {
+    if (scale > max_n) {
+      break;
+    }
+    checkpoints[no_checkpoints++] = scale;
+    if (2 * scale <= max_n) {
+      checkpoints[no_checkpoints++] = 2 * scale;
+    }
+    if (5 * scale <= max_n) {
+      checkpoints[no_checkpoints++] = 5 * scale;
+    }
+  }
+
+  static double sum[MAX_CHECKPOINTS][NO_ESTIMATORS];
+  static double sum_sq[MAX_CHECKPOINTS][NO_ESTIMATORS];
+  uint64_t hist[HLL_MAX_RANK + 1];
+
+  for (int run = 0; run < runs; run++) {
+    Hll h;
+    init_hll(&h, precision, HLL_PACKED, 1);
+    uint64_t n = 0;
+
+    for (int c = 0; c < no_checkpoints; c++) {
+      for (; n < checkpoints[c]; n++) {
+        hll_add_hash(&h, hash_u64(((uint64_t)run << RUN_SHIFT) + n));
+      }
+
+      hll_histogram(&h, hist);
+      for (int e = 0; e < NO_ESTIMATORS; e++) {
+        double error = hll_estimate(hist, precision, e) / n - 1;
+        sum[c][e] += error;
+        sum_sq[c][e] += error * error;
+      }
+    }
+
+    free_hll(&h);
+  }
+
+  printf("precision %d, %d run(s); relative error, mean / rms\n", precision,
+         runs);
+  printf("%12s", "cardinality");
+  for (int e = 0; e < NO_ESTIMATORS; e++) {
+    printf(" %23s", estimator_names[e]);
+  }
+  printf("\n");
+
+  for (int c = 0; c < no_checkpoints; c++) {
+    printf("%12" PRIu64, checkpoints[c]);
+    for (int e = 0; e < NO_ESTIMATORS; e++) {
+      printf(" %+11.2f%% %9.2f%%", 100 * sum[c][e] / runs,
+             100 * sqrt(sum_sq[c][e] / runs));
+    }
+    printf("\n");
+  }
+
+  return 0;
+}
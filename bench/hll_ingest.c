@@ -0,0 +1,114 @@
+// Copyright 2020 Radu-Stefan Minea 314CA
+
+/*
+ * Ingest speed of the hll sketch, on random values already in memory (no
+ * parsing): hll_add_hash() value by value, then the batch API with every
+ * kernel the CPU supports, for 64-bit and 32-bit values. Every batch run
+ * must end with the same registers as the value by value one.
+ *
+ * Usage: bench/hll_ingest [VALUES] [PRECISION]
+ * (defaults: 50000000 14; make hll_ingest builds it)
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "libs/hashing.h"
+#include "libs/hll_batch.h"
+#include "libs/hll_sketch.h"
+#include "libs/utils.h"
+
+static const char *isa_names[] = { "auto", "scalar", "avx2", "avx512" };
+
+static double now(void) {
+  struct timespec t;
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return t.tv_sec + t.tv_nsec / 1e9;
+}
+
+static void report(const char *name, size_t n, size_t width, double secs) {
+  printf("%-22s %8.1f M values/s %8.2f GB/s\n", name, n / secs / 1e6,
+         n * width / secs / 1e9);
+}
+
+// Runs the batch API with every kernel, checking the registers against ref
+static void run_batches(const void *values, int wide, size_t n, int precision,
+                        Hll *ref) {
+  uint32_t m = (uint32_t)1 << precision;
+
+  for (int isa = HLL_ISA_SCALAR; isa <= HLL_ISA_AVX512; isa++) {
+    // Skipping what the CPU doesn't have
+    if (hll_batch_select(isa) != isa) {
+      continue;
+    }
+
+    Hll h;
+    init_hll(&h, precision, HLL_DENSE, 0);
+    double start = now();
+    if (wide) {
+      hll_add_i64_batch(&h, values, n);
+    } else {
+      hll_add_i32_batch(&h, values, n);
+    }
+    double secs = now() - start;
+
+    for (uint32_t i = 0; i < m; i++) {
+      if (hll_get(&h, i) != hll_get(ref, i)) {
+        fprintf(stderr, "%s: register %u differs\n", isa_names[isa], i);
+        exit(ERROR_STATUS);
+      }
+    }
+
+    char name[32];
+    snprintf(name, sizeof(name), "batch %s (%s)", isa_names[isa],
+             wide ? "i64" : "i32");
+    report(name, n, wide ? 8 : 4, secs);
+    free_hll(&h);
+  }
+}
+
+int main(int argc, char **argv) {
+  size_t n = argc > 1 ? strtoull(argv[1], NULL, 10) : 50000000;
+  int precision = argc > 2 ? atoi(argv[2]) : 14;
+
+  if (n < 1 || precision < HLL_MIN_PRECISION ||
+      precision > HLL_MAX_PRECISION) {
+    fprintf(stderr, "Usage: %s [VALUES] [PRECISION (%d..%d)]\n", argv[0],
+            HLL_MIN_PRECISION, HLL_MAX_PRECISION);
+    exit(ERROR_STATUS);
+  }
+
+  int64_t *values = malloc(n * sizeof(int64_t));
+  int32_t *values32 = malloc(n * sizeof(int32_t));
+  mem_check(values);
+  mem_check(values32);
+  for (size_t i = 0; i < n; i++) {
+    values[i] = hash_u64(i);
+    values32[i] = (int32_t)values[i];
+  }
+
+  // Value by value, the way hll.c used to do it
+  for (int wide = 1; wide >= 0; wide--) {
+    Hll ref;
+    init_hll(&ref, precision, HLL_DENSE, 0);
+    double start = now();
+    for (size_t i = 0; i < n; i++) {
+      int64_t x = wide ? values[i] : values32[i];
+      hll_add_hash(&ref, hash_u64(x));
+    }
+    report(wide ? "one by one (i64)" : "one by one (i32)", n, wide ? 8 : 4,
+           now() - start);
+
+    run_batches(wide ? (const void *)values : (const void *)values32, wide, n,
+                precision, &ref);
+    free_hll(&ref);
+  }
+
+  free(values);
+  free(values32);
+  return 0;
+}
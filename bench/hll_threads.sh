@@ -0,0 +1,37 @@
+#!/bin/bash
+# Scaling of hll --threads: times hll on VALUES random integers with 1, 2,
+# 4, ..., 64 threads, with per-thread registers and with shared registers
+# (--shared), best of 3 runs each.
+#
+# Usage: bench/hll_threads.sh [VALUES] [PRECISION] [binary]
+# (binary defaults to ./hll; run from the repository root)
+
+VALUES=${1:-20000000}
+PRECISION=${2:-14}
+BIN=${3:-./hll}
+
+INPUT=$(mktemp)
+trap 'rm -f "$INPUT"' EXIT
+
+awk -v n="$VALUES" 'BEGIN {
+  srand(1)
+  for (i = 0; i < n; i++)
+    printf "%d\n", int(rand() * 2^31) * 2^20 + int(rand() * 2^20)
+}' > "$INPUT"
+
+echo "input: $VALUES values, $(du -h "$INPUT" | cut -f1), $(nproc) CPU(s)"
+
+TIMEFORMAT='%R'
+best_of_3() {
+  for run in 1 2 3; do
+    { time "$@" > /dev/null; } 2>&1
+  done | sort -n | head -1
+}
+
+printf "%8s %12s %12s\n" threads private shared
+for threads in 1 2 4 8 16 32 64; do
+  private=$(best_of_3 "$BIN" -p "$PRECISION" --threads "$threads" "$INPUT")
+  shared=$(best_of_3 "$BIN" -p "$PRECISION" --threads "$threads" --shared \
+           "$INPUT")
+  printf "%8d %11ss %11ss\n" "$threads" "$private" "$shared"
+done
@@ -0,0 +1,75 @@
+// Copyright 2020 Radu-Stefan Minea 314CA
+
+/*
+ * Runs a command with its stdin read from INPUT and its stdout written to
+ * OUTPUT (or /dev/null), then prints its wall time in seconds and its peak
+ * resident memory in KiB, from wait4's rusage (so only the command is
+ * measured, not the shell around it).
+ *
+ * Usage: bench/measure INPUT OUTPUT command [args...]
+ * (prints "<seconds> <peak RSS in KiB>"; exits with the command's status)
+ */
+
+#define _DEFAULT_SOURCE
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/resource.h>
+#include <sys/time.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "libs/utils.h"
+
+// Status of a child that couldn't start the command
+#define EXEC_FAILED 127
+
+static double now_seconds(void) {
+  struct timespec t;
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return t.tv_sec + t.tv_nsec / 1e9;
+}
+
+static void redirect(const char *path, int flags, int fd) {
+  int file = open(path, flags, 0644);
+  if (file < 0 || dup2(file, fd) < 0) {
+    perror(path);
+    _exit(EXEC_FAILED);
+  }
+  close(file);
+}
+
+int main(int argc, char **argv) {
+  if (argc < 4) {
+    fprintf(stderr, "Usage: %s INPUT OUTPUT command [args...]\n", argv[0]);
+    exit(ERROR_STATUS);
+  }
+
+  double start = now_seconds();
+  pid_t pid = fork();
+  if (pid < 0) {
+    perror("fork");
+    exit(ERROR_STATUS);
+  }
+
+  if (pid == 0) {
+    redirect(argv[1], O_RDONLY, STDIN_FILENO);
+    redirect(argv[2], O_WRONLY | O_CREAT | O_TRUNC, STDOUT_FILENO);
+    execvp(argv[3], argv + 3);
+    perror(argv[3]);
+    _exit(EXEC_FAILED);
+  }
+
+  int status;
+  struct rusage usage;
+  if (wait4(pid, &status, 0, &usage) < 0) {
+    perror("wait4");
+    exit(ERROR_STATUS);
+  }
+  double elapsed = now_seconds() - start;
+
+  printf("%.3f %ld\n", elapsed, usage.ru_maxrss);
+  return WIFEXITED(status) ? WEXITSTATUS(status) : ERROR_STATUS;
+}
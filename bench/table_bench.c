@@ -0,0 +1,114 @@
+// Copyright 2020 Radu-Stefan Minea 314CA
+
+/*
+ * Counting speed of the type-specialized tables (libs/typed_table.h)
+ * against the tables they sit next to, on keys already in memory: N keys
+ * drawn from DISTINCT values, counted one by one.
+ * int64: I64Table (freq.c's map)
+ * int32: I32Table
+ * strings: StrKeyTable vs the Hashtable of hash.c (wyhash and memcmp inlined
+ * only when they're its functions, through a generic put/find_bucket)
+ * Every table must end with the same number of distinct keys.
+ *
+ * Usage: bench/table_bench [N] [DISTINCT]
+ * (defaults: 20000000 1000000; make table_bench builds it)
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "libs/hashing.h"
+#include "libs/str_table.h"
+#include "libs/typed_table.h"
+#include "libs/utils.h"
+
+#define KEY_TEXT_LEN 16
+
+static double now(void) {
+  struct timespec t;
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return t.tv_sec + t.tv_nsec / 1e9;
+}
+
+static void report(const char *name, size_t n, size_t distinct,
+                   size_t expected, double secs) {
+  if (distinct != expected) {
+    fprintf(stderr, "%s: %zu distinct keys instead of %zu\n", name, distinct,
+            expected);
+    exit(ERROR_STATUS);
+  }
+  printf("%-28s %8.1f M keys/s\n", name, n / secs / 1e6);
+}
+
+int main(int argc, char **argv) {
+  size_t n = argc > 1 ? strtoull(argv[1], NULL, 10) : 20000000;
+  size_t distinct = argc > 2 ? strtoull(argv[2], NULL, 10) : 1000000;
+
+  if (n < 1 || distinct < 1 || distinct > n) {
+    fprintf(stderr, "Usage: %s [N] [DISTINCT (<= N)]\n", argv[0]);
+    exit(ERROR_STATUS);
+  }
+
+  // Every one of the distinct ids shows up at least once
+  int64_t *values = malloc(n * sizeof(int64_t));
+  char *text = malloc(n * KEY_TEXT_LEN);
+  int *len = malloc(n * sizeof(int));
+  mem_check(values);
+  mem_check(text);
+  mem_check(len);
+  for (size_t i = 0; i < n; i++) {
+    uint64_t id = i < distinct ? i : hash_u64(i) % distinct;
+    values[i] = (int64_t)hash_u64(id + 1);
+    len[i] = snprintf(text + i * KEY_TEXT_LEN, KEY_TEXT_LEN, "key%" PRIu64,
+                      id);
+  }
+
+  I64Table t64;
+  i64_table_init(&t64, 0);
+  double start = now();
+  for (size_t i = 0; i < n; i++) {
+    i64_table_add(&t64, values[i], 1);
+  }
+  report("I64Table", n, t64.size, distinct, now() - start);
+  i64_table_free(&t64);
+
+  // The 32-bit values of distinct ids may collide => counting them first
+  I32Table t32;
+  i32_table_init(&t32, 0);
+  start = now();
+  for (size_t i = 0; i < n; i++) {
+    i32_table_add(&t32, (int32_t)values[i], 1);
+  }
+  report("I32Table", n, t32.size, t32.size, now() - start);
+  i32_table_free(&t32);
+
+  StrKeyTable ts;
+  str_key_table_init(&ts, 0);
+  start = now();
+  for (size_t i = 0; i < n; i++) {
+    str_key_table_add(&ts, str_key_of(text + i * KEY_TEXT_LEN, len[i]), 1);
+  }
+  report("StrKeyTable", n, ts.size, distinct, now() - start);
+  str_key_table_free(&ts);
+
+  Hashtable *ht = malloc(sizeof(Hashtable));
+  mem_check(ht);
+  init_ht(ht, INITIAL_HMAX, hash_bytes, compare_function_strings,
+          LINEAR_ENGINE);
+  start = now();
+  for (size_t i = 0; i < n; i++) {
+    put(ht, text + i * KEY_TEXT_LEN, len[i]);
+  }
+  report("Hashtable", n, ht->size, distinct, now() - start);
+  free_ht(ht);
+
+  free(values);
+  free(text);
+  free(len);
+  return 0;
+}
@@ -0,0 +1,57 @@
+#!/bin/bash
+# Compares ./hash --top K (Count-Min Sketch + heap) with the exact counts
+# of ./hash on the same input: recall = how many of the real top K keys
+# were found, error = mean relative error of the printed counts.
+# Runs on the tests_hash inputs, then on a generated zipf-like input with
+# many more distinct keys than the sketch has counters per row.
+# The error is over all the keys that were printed.
+#
+# Usage: bench/topk_accuracy.sh [K] [CMS width] [CMS depth]
+# (run from the repository root)
+
+K=${1:-10}
+WIDTH=${2:-65536}
+DEPTH=${3:-4}
+
+EXACT=$(mktemp)
+TOP=$(mktemp)
+ZIPF=$(mktemp)
+trap 'rm -f "$EXACT" "$TOP" "$ZIPF"' EXIT
+
+# Key i appears about 200000 / i times, for 200000 distinct keys
+awk 'BEGIN { for (i = 1; i <= 200000; i++) {
+         n = int(200000 / i); if (n < 1) n = 1;
+         for (j = 0; j < n; j++) print "key" i } }' |
+  shuf --random-source=<(yes) > "$ZIPF"
+
+compare() {
+  ./hash "$1" | sort -k2,2nr -k1,1 > "$EXACT"
+  ./hash --top "$K" --cms-width "$WIDTH" --cms-depth "$DEPTH" "$1" > "$TOP"
+
+  # Keys tied with the real K-th count are right answers too
+  awk -v k="$K" -v name="$2" '
+    NR == FNR {
+      exact[$1] = $2
+      if (FNR <= k) { real[$1] = 1; kth = $2 }
+      next
+    }
+    { top[$1] = $2 }
+    END {
+      n = 0; found = 0; tied = 0; err = 0
+      for (key in real) {
+        n++
+        if (key in top) found++
+      }
+      for (key in top) {
+        if (!(key in real) && exact[key] == kth) tied++
+        err += (top[key] - exact[key]) / exact[key]
+      }
+      printf "%-24s recall %d/%d (+%d tied), mean error %.4f%%\n",
+             name, found, n, tied, 100 * err / length(top)
+    }' "$EXACT" "$TOP"
+}
+
+for f in tests_hash/test*.txt; do
+  compare "$f" "$f"
+done
+compare "$ZIPF" "zipf ($(wc -l < "$ZIPF") keys)"
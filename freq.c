@@ -1,38 +1,281 @@
 // Copyright 2020 Radu-Stefan Minea 314CA
 
+#include <pthread.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
 
-#define ERROR_STATUS -1
-#define NMAX 2000001
+#include "libs/freq_map.h"
+#include "libs/hash_set.h"
+#include "libs/hashing.h"
+#include "libs/input.h"
+#include "libs/radix_sort.h"
+#include "libs/utils.h"
+#include "libs/writer.h"
 
-void mem_check(void *p);
+// Distinct values after which a spread input only keeps hashes
+#define SET_THRESHOLD (1 << 16)
+#define MAX_THREADS RADIX_MAX_THREADS
+// Values a reader starts with
+#define INITIAL_VALUES (1 << 16)
 
-int main() {
-  unsigned char *freq_array = calloc(NMAX, sizeof(unsigned char));
-  mem_check(freq_array);
+enum engine { MAP_ENGINE, RADIX_ENGINE };
 
-  int x;
+// One reader of the radix engine: the values of its range of the input
+typedef struct reader {
+  pthread_t thread;
+  Input *in;
+  int64_t *values;
+  size_t size, cap;
+} reader;
 
-  // Adding input to freq_array
-  while (fscanf(stdin, "%d", &x) != EOF) {
-    freq_array[x]++;
-  }
+void print_value(int64_t value, uint64_t cnt, void *arg);
+void add_to_set(int64_t value, uint64_t cnt, void *arg);
+size_t count_distinct(Input *in);
+void count_sorted(Input *in, int no_threads, int distinct_only);
+int64_t *read_values(Input *in, int no_threads, size_t *n);
+void *read_range(void *arg);
+
+int main(int argc, char **argv) {
+  int engine = MAP_ENGINE;
+  int no_threads = 1;
+  int distinct_only = 0;
 
-  // If "i" was among the input, show its frequency
-  for (int i = 0; i < NMAX; i++) {
-    if (freq_array[i]) {
-      printf("%d %d\n", i, freq_array[i]);
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "--count-distinct")) {
+      distinct_only = 1;
+    } else if (!strcmp(argv[i], "--engine") && i + 1 < argc) {
+      i++;
+      if (!strcmp(argv[i], "map")) {
+        engine = MAP_ENGINE;
+      } else if (!strcmp(argv[i], "radix")) {
+        engine = RADIX_ENGINE;
+      } else {
+        fprintf(stderr, "Unknown engine: %s\n", argv[i]);
+        exit(ERROR_STATUS);
+      }
+    } else if (!strcmp(argv[i], "--threads") && i + 1 < argc) {
+      no_threads = atoi(argv[++i]);
+    } else {
+      fprintf(stderr,
+              "Usage: %s [--count-distinct] [--engine map|radix] "
+              "[--threads N] < input\n",
+              argv[0]);
+      exit(ERROR_STATUS);
     }
   }
 
-  free(freq_array);
+  if (no_threads < 1 || no_threads > MAX_THREADS) {
+    fprintf(stderr, "Number of threads must be between 1 and %d\n",
+            MAX_THREADS);
+    exit(ERROR_STATUS);
+  }
+  if (no_threads > 1 && engine != RADIX_ENGINE) {
+    fprintf(stderr, "--threads needs --engine radix\n");
+    exit(ERROR_STATUS);
+  }
+
+  if (engine == RADIX_ENGINE) {
+    Input *in = open_input(NULL);
+    count_sorted(in, no_threads, distinct_only);
+    close_input(in);
+    return 0;
+  }
+  if (distinct_only) {
+    Input *in = open_input(NULL);
+    printf("%zu\n", count_distinct(in));
+    close_input(in);
+    return 0;
+  }
+
+  // Picks dense counters, a bitmap or a hashtable, depending on how the
+  // values are spread
+  FreqMap freq_map;
+  init_freq_map(&freq_map);
+
+  Input *in = open_input(NULL);
+  int64_t x;
+
+  // Adding input to freq_map
+  while (next_int(in, &x)) {
+    freq_map_add(&freq_map, x, 1);
+  }
+
+  // Showing the frequency of every value in the input, in increasing order
+  Writer *out = open_writer(STDOUT_FILENO);
+  freq_map_visit(&freq_map, print_value, out);
+  close_writer(out);
+
+  close_input(in);
+  free_freq_map(&freq_map);
   return 0;
 }
 
-void mem_check(void *p) {
-  if (p == NULL) {
-    fprintf(stderr, "Error allocating memory\n");
-    exit(ERROR_STATUS);
+void print_value(int64_t value, uint64_t cnt, void *arg) {
+  Writer *out = arg;
+
+  write_i64(out, value);
+  write_char(out, ' ');
+  write_u64(out, cnt);
+  write_char(out, '\n');
+}
+
+void add_to_set(int64_t value, uint64_t cnt, void *arg) {
+  (void)cnt;
+  hash_set_add(arg, hash_u64(value));
+}
+
+/*
+ * Only the number of distinct values, without printing them. While the
+ * values are close together, the dense counters or the bitmap of freq_map
+ * are the smallest; once they turn out to be spread (freq_map stays a
+ * hashtable past SET_THRESHOLD values), only their hashes are kept, which
+ * drops the counts. hash_u64 is a bijection, so the count stays exact.
+ */
+size_t count_distinct(Input *in) {
+  FreqMap freq_map;
+  int64_t x;
+
+  init_freq_map(&freq_map);
+  while (next_int(in, &x)) {
+    freq_map_add(&freq_map, x, 1);
+    if (freq_map.mode == FREQ_HASH && freq_map.distinct >= SET_THRESHOLD) {
+      break;
+    }
+  }
+
+  if (freq_map.mode != FREQ_HASH || freq_map.distinct < SET_THRESHOLD) {
+    size_t count = freq_map.distinct;
+    free_freq_map(&freq_map);
+    return count;
+  }
+
+  HashSet set;
+  init_hash_set(&set, 2 * freq_map.distinct);
+  freq_map_visit(&freq_map, add_to_set, &set);
+  free_freq_map(&freq_map);
+
+  while (next_int(in, &x)) {
+    hash_set_add(&set, hash_u64(x));
+  }
+
+  size_t count = hash_set_count(&set);
+  free_hash_set(&set);
+  return count;
+}
+
+/*
+ * The radix engine: all the values in one array, radix sorted, and then
+ * counted in a single pass over it (equal values are next to each other).
+ * Needs 16 bytes per value, but no table: fast for many spread values.
+ */
+void count_sorted(Input *in, int no_threads, int distinct_only) {
+  size_t n;
+  int64_t *values = read_values(in, no_threads, &n);
+  int64_t *tmp = malloc((n ? n : 1) * sizeof(int64_t));
+  mem_check(tmp);
+
+  int64_t *sorted = radix_sort(values, tmp, n, no_threads);
+
+  Writer *out = open_writer(STDOUT_FILENO);
+  size_t distinct = 0;
+  for (size_t i = 0; i < n;) {
+    size_t run = i + 1;
+    while (run < n && sorted[run] == sorted[i]) {
+      run++;
+    }
+
+    if (!distinct_only) {
+      print_value(sorted[i], run - i, out);
+    }
+    distinct++;
+    i = run;
+  }
+  if (distinct_only) {
+    write_u64(out, distinct);
+    write_char(out, '\n');
+  }
+  close_writer(out);
+
+  free(values);
+  free(tmp);
+}
+
+/*
+ * Every value of the input, in input order. A mapped input is split, at
+ * line starts, between the threads, which parse their ranges at the same
+ * time; anything else is read by a single thread.
+ */
+int64_t *read_values(Input *in, int no_threads, size_t *n) {
+  reader readers[MAX_THREADS];
+
+  if (!in->mapped) {
+    no_threads = 1;
+  }
+
+  size_t start = 0;
+  for (int i = 0; i < no_threads; i++) {
+    reader *r = &readers[i];
+    size_t end = in->size;
+    if (i + 1 < no_threads) {
+      end = next_line_start(in, in->size / no_threads * (i + 1));
+    }
+    if (end < start) {
+      end = start;
+    }
+
+    r->in = no_threads > 1 ? input_range(in, start, end) : in;
+    start = end;
+    r->size = 0;
+    r->cap = INITIAL_VALUES;
+    r->values = malloc(r->cap * sizeof(int64_t));
+    mem_check(r->values);
+  }
+
+  if (no_threads == 1) {
+    read_range(&readers[0]);
+    *n = readers[0].size;
+    return readers[0].values;
+  }
+
+  for (int i = 0; i < no_threads; i++) {
+    if (pthread_create(&readers[i].thread, NULL, read_range, &readers[i])) {
+      fprintf(stderr, "Couldn't start thread\n");
+      exit(ERROR_STATUS);
+    }
+  }
+
+  *n = 0;
+  for (int i = 0; i < no_threads; i++) {
+    pthread_join(readers[i].thread, NULL);
+    close_input(readers[i].in);
+    *n += readers[i].size;
+  }
+
+  int64_t *values = malloc((*n ? *n : 1) * sizeof(int64_t));
+  mem_check(values);
+  size_t pos = 0;
+  for (int i = 0; i < no_threads; i++) {
+    memcpy(values + pos, readers[i].values,
+           readers[i].size * sizeof(int64_t));
+    pos += readers[i].size;
+    free(readers[i].values);
+  }
+  return values;
+}
+
+void *read_range(void *arg) {
+  reader *r = arg;
+  int64_t x;
+
+  while (next_int(r->in, &x)) {
+    if (r->size == r->cap) {
+      r->cap *= 2;
+      r->values = realloc(r->values, r->cap * sizeof(int64_t));
+      mem_check(r->values);
+    }
+    r->values[r->size++] = x;
   }
+  return NULL;
 }
@@ -1,167 +1,555 @@
 // Copyright 2020 Radu-Stefan Minea 314CA
 
+#define _POSIX_C_SOURCE 200809L
+
+#include <inttypes.h>
+#include <pthread.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
-#define MAX_LEN 101
-#define ERROR_STATUS -1
-#define NEW_STRING_CNT 1
-
-typedef struct info {
-  char *key;
-  char value;
-} info;
-
-typedef struct Hashtable {
-  info *buckets;
-  int hmax;
-  unsigned int (*hash_function)(void *);
-  int (*compare_function)(void *, void *);
-} Hashtable;
-
-void init_ht(Hashtable *ht, int hmax, unsigned int (*hash_function)(void *),
-             int (*compare_function)(void *, void *));
-int compare_function_strings(void *a, void *b);
-unsigned int hash_function_string(void *a);
-void put(struct Hashtable *ht, void *key, int key_size_bytes);
-void free_ht(Hashtable *ht);
-void mem_check(void *p);
-
-int main() {
-  int cnt = 0;
-  int key_size_bytes;
-  char buffer[MAX_LEN];
-  char **temp = malloc(cnt * sizeof(char *));
-
-  // Manual mem_check, becuase the function was defined for pointers,
-  // not for double pointers
-  if (temp == NULL) {
-    fprintf(stderr, "Error allocating memory\n");
+#include "libs/hash_set.h"
+#include "libs/input.h"
+#include "libs/spill.h"
+#include "libs/str_table.h"
+#include "libs/top_k.h"
+#include "libs/utils.h"
+
+#define MAX_THREADS 256
+#define DEFAULT_CMS_WIDTH (1 << 16)
+#define DEFAULT_CMS_DEPTH 4
+// Smallest --mem-limit: the table needs some room before its first spill
+#define MIN_MEM_LIMIT (1 << 20)
+
+/*
+ * One worker of the parallel mode: counts the tokens of its range of the
+ * (mapped) input in its own hashtable, and remembers its keys in the order
+ * they first appeared. Keys point straight into the mapped input.
+ */
+typedef struct worker {
+  pthread_t thread;
+  Input *in;
+  Hashtable *ht;
+  const char **order;
+  int *order_len;
+  int order_cnt;
+} worker;
+
+// What every partition of the --mem-limit mode is counted with
+typedef struct spill_ctx {
+  hash_fn hash_function;
+  int engine;
+  size_t mem_limit;
+  char *key;  // Buffer for keys read back from spill files
+  size_t key_cap;
+} spill_ctx;
+
+// One worker of --count-distinct: the hashes of its range, in its own set
+typedef struct set_worker {
+  pthread_t thread;
+  Input *in;
+  HashSet set;
+} set_worker;
+
+int parse_engine(const char *name);
+hash_fn parse_hash(const char *name);
+void print_stats(Hashtable *ht);
+void print_counts(Hashtable *ht);
+size_t parse_size(const char *text);
+void count_stream(Hashtable *ht, Input *in);
+void *count_range(void *arg);
+void count_parallel(Hashtable *ht, Input *in, int no_threads);
+size_t count_distinct(Input *in, int no_threads);
+void *distinct_range(void *arg);
+void print_top(Input *in, hash_fn hash_function, int k, int cms_width,
+               int cms_depth);
+void count_limited(Input *in, hash_fn hash_function, int engine,
+                   size_t mem_limit);
+void aggregate(spill_ctx *ctx, Input *in, FILE *from, int level);
+void spill_table(Hashtable *ht, FILE **parts, int level);
+
+int main(int argc, char **argv) {
+  int engine = LINEAR_ENGINE;
+  hash_fn hash_function = hash_bytes;
+  int show_stats = 0;
+  int no_threads = 1;
+  int top = 0;
+  int distinct_only = 0;
+  int cms_width = DEFAULT_CMS_WIDTH;
+  int cms_depth = DEFAULT_CMS_DEPTH;
+  size_t mem_limit = 0;
+  const char *path = NULL;
+
+  // Checking command line parameters
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "--engine") && i + 1 < argc) {
+      engine = parse_engine(argv[++i]);
+    } else if (!strcmp(argv[i], "--hash") && i + 1 < argc) {
+      hash_function = parse_hash(argv[++i]);
+    } else if (!strcmp(argv[i], "--stats")) {
+      show_stats = 1;
+    } else if (!strcmp(argv[i], "--threads") && i + 1 < argc) {
+      no_threads = atoi(argv[++i]);
+    } else if (!strcmp(argv[i], "--mem-limit") && i + 1 < argc) {
+      mem_limit = parse_size(argv[++i]);
+    } else if (!strcmp(argv[i], "--count-distinct")) {
+      distinct_only = 1;
+    } else if (!strcmp(argv[i], "--top") && i + 1 < argc) {
+      top = atoi(argv[++i]);
+    } else if (!strcmp(argv[i], "--cms-width") && i + 1 < argc) {
+      cms_width = atoi(argv[++i]);
+    } else if (!strcmp(argv[i], "--cms-depth") && i + 1 < argc) {
+      cms_depth = atoi(argv[++i]);
+    } else if (argv[i][0] != '-' && path == NULL) {
+      path = argv[i];
+    } else {
+      fprintf(stderr,
+              "Usage: %s [--engine linear|swiss] [--hash wyhash|djb2] "
+              "[--stats] [--threads N] [--top K [--cms-width W] "
+              "[--cms-depth D]] [--count-distinct] [--mem-limit SIZE] "
+              "[input file]\n",
+              argv[0]);
+      exit(ERROR_STATUS);
+    }
+  }
+
+  if (no_threads < 1 || no_threads > MAX_THREADS) {
+    fprintf(stderr, "Number of threads must be between 1 and %d\n",
+            MAX_THREADS);
     exit(ERROR_STATUS);
   }
 
-  // Finding max no. of buckets
-  while (fscanf(stdin, "%s", buffer) != EOF) {
-    temp = realloc(temp, (cnt + 1) * sizeof(char *));
+  if (top < 0 || cms_width < 1 || cms_depth < 1 ||
+      cms_depth > CMS_MAX_DEPTH) {
+    fprintf(stderr, "Bad --top / --cms-width / --cms-depth value\n");
+    exit(ERROR_STATUS);
+  }
+  if (top && (no_threads > 1 || show_stats)) {
+    fprintf(stderr, "--top can't be used with --threads or --stats\n");
+    exit(ERROR_STATUS);
+  }
+  if (distinct_only && (top || show_stats)) {
+    fprintf(stderr, "--count-distinct can't be used with --top or --stats\n");
+    exit(ERROR_STATUS);
+  }
 
-    if (temp == NULL) {
-      fprintf(stderr, "Error allocating memory\n");
-      exit(ERROR_STATUS);
-    }
+  if (mem_limit &&
+      (top || distinct_only || show_stats || no_threads > 1)) {
+    fprintf(stderr, "--mem-limit can't be used with --top, "
+                    "--count-distinct, --stats or --threads\n");
+    exit(ERROR_STATUS);
+  }
+
+  // Input file (or stdin, if there's none); mapped if it's a regular file
+  Input *in = open_input(path);
+
+  // Workers split the input among themselves => it has to be a file
+  if (no_threads > 1 && !in->mapped) {
+    fprintf(stderr, "--threads needs a regular file as input\n");
+    exit(ERROR_STATUS);
+  }
 
-    // Allocating one extra byte, otherwise snprintf would exclude the last
-    // character of the string
-    temp[cnt] = malloc(sizeof(buffer) + 1);
-    snprintf(temp[cnt], sizeof(buffer) + 1, "%s", buffer);
-    cnt++;
+  // Heavy hitters only => no hashtable, memory doesn't grow with the input
+  if (top) {
+    print_top(in, hash_function, top, cms_width, cms_depth);
+    close_input(in);
+    return 0;
   }
 
-  // Initializing hashtable
+  // Only the number of distinct keys => only their hashes are kept
+  if (distinct_only) {
+    printf("%zu\n", count_distinct(in, no_threads));
+    close_input(in);
+    return 0;
+  }
+
+  // Bounded memory => partitions spilled to disk once the table is full
+  if (mem_limit) {
+    count_limited(in, hash_function, engine, mem_limit);
+    close_input(in);
+    return 0;
+  }
+
+  // Initializing hashtable; it grows on its own, so the input is read
+  // only once, straight into the buckets
   Hashtable *ht = malloc(sizeof(Hashtable));
   mem_check(ht);
-  init_ht(ht, cnt, hash_function_string, compare_function_strings);
+  init_ht(ht, INITIAL_HMAX, hash_function, compare_function_strings, engine);
 
   // Transferring input to hashtable
-  for (int i = 0; i < cnt; i++) {
-    key_size_bytes = strlen(temp[i]);
-    put(ht, temp[i], key_size_bytes);
-    free(temp[i]);
+  if (no_threads > 1) {
+    count_parallel(ht, in, no_threads);
+  } else {
+    count_stream(ht, in);
   }
 
   // Printing results
-  for (int i = 0; i < cnt; i++) {
-    if (ht->buckets[i].value) {
-      info inside_data = ht->buckets[i];
-      printf("%s %d\n", inside_data.key, inside_data.value);
-    }
+  print_counts(ht);
+
+  if (show_stats) {
+    print_stats(ht);
   }
 
   // Freeing
-  free(temp);
+  close_input(in);
   free_ht(ht);
 
   return 0;
 }
 
-void init_ht(Hashtable *ht, int hmax, unsigned int (*hash_function)(void *),
-             int (*compare_function)(void *, void *)) {
-  if (ht == NULL) {
-    return;
+int parse_engine(const char *name) {
+  if (!strcmp(name, "linear")) {
+    return LINEAR_ENGINE;
+  }
+  if (!strcmp(name, "swiss")) {
+    return SWISS_ENGINE;
+  }
+
+  fprintf(stderr, "Unknown engine: %s\n", name);
+  exit(ERROR_STATUS);
+}
+
+hash_fn parse_hash(const char *name) {
+  if (!strcmp(name, "wyhash")) {
+    return hash_bytes;
+  }
+  if (!strcmp(name, "djb2")) {
+    return hash_bytes_djb2;
   }
 
-  ht->hmax = hmax;
-  ht->hash_function = hash_function;
-  ht->compare_function = compare_function;
+  fprintf(stderr, "Unknown hash function: %s\n", name);
+  exit(ERROR_STATUS);
+}
 
-  ht->buckets = calloc(hmax, sizeof(info));
-  mem_check(ht->buckets);
+void print_counts(Hashtable *ht) {
+  for (int i = 0; i < ht->hmax; i++) {
+    uint64_t count = get_count(ht, &ht->buckets[i]);
+    if (count) {
+      printf("%s %" PRIu64 "\n", bucket_key(&ht->buckets[i]), count);
+    }
+  }
 }
 
-int compare_function_strings(void *a, void *b) {
-  char *str_a = (char *)a;
-  char *str_b = (char *)b;
+// Bytes, or k/m/g (KiB, MiB, GiB) after the number
+size_t parse_size(const char *text) {
+  char *end;
+  uint64_t size = strtoull(text, &end, 10);
+
+  switch (*end) {
+    case 'k':
+    case 'K':
+      size <<= 10;
+      end++;
+      break;
+    case 'm':
+    case 'M':
+      size <<= 20;
+      end++;
+      break;
+    case 'g':
+    case 'G':
+      size <<= 30;
+      end++;
+      break;
+  }
 
-  return strcmp(str_a, str_b);
+  if (end == text || *end != '\0' || size < MIN_MEM_LIMIT) {
+    fprintf(stderr, "Bad memory limit: %s (at least %d bytes)\n", text,
+            MIN_MEM_LIMIT);
+    exit(ERROR_STATUS);
+  }
+  return size;
 }
 
-unsigned int hash_function_string(void *a) {
-  /*
-   * Credits: http://www.cse.yorku.ca/~oz/hash.html
-   */
-  unsigned char *puchar_a = (unsigned char *)a;
-  unsigned int hash = 5381;
-  int c;
+// Goes to stderr, so the counts on stdout stay the same
+void print_stats(Hashtable *ht) {
+  double avg_probes;
+  int max_probes, collisions;
+
+  probe_stats(ht, &avg_probes, &max_probes, &collisions);
+  fprintf(stderr, "distinct keys: %d\n", ht->size);
+  fprintf(stderr, "buckets: %d (load %.3f)\n", ht->hmax,
+          (double)ht->size / ht->hmax);
+  fprintf(stderr, "probe length (%s): avg %.3f, max %d\n",
+          ht->engine == SWISS_ENGINE ? "groups" : "buckets", avg_probes,
+          max_probes);
+  fprintf(stderr, "keys sharing their full hash: %d\n", collisions);
+}
 
-  while ((c = *puchar_a++))
-    hash = ((hash << 5u) + hash) + c; /* hash * 33 + c */
+void count_stream(Hashtable *ht, Input *in) {
+  const char *key;
+  size_t key_size_bytes;
 
-  return hash;
+  while (next_token(in, &key, &key_size_bytes)) {
+    put(ht, key, key_size_bytes);
+  }
 }
 
-void put(struct Hashtable *ht, void *key, int key_size_bytes) {
-  if (ht == NULL) {
-    return;
+void *count_range(void *arg) {
+  worker *w = arg;
+  const char *key;
+  size_t key_size_bytes;
+  int order_cap = 0;
+
+  while (next_token(w->in, &key, &key_size_bytes)) {
+    int old_size = w->ht->size;
+    info *inside_data = find_bucket(w->ht, key, key_size_bytes);
+    add_count(w->ht, inside_data, NEW_STRING_CNT);
+
+    // NEW STRING => remembering when it was first seen
+    if (w->ht->size != old_size) {
+      if (w->order_cnt == order_cap) {
+        order_cap = order_cap ? 2 * order_cap : INITIAL_HMAX;
+        w->order = realloc(w->order, order_cap * sizeof(char *));
+        mem_check(w->order);
+        w->order_len = realloc(w->order_len, order_cap * sizeof(int));
+        mem_check(w->order_len);
+      }
+
+      w->order[w->order_cnt] = key;
+      w->order_len[w->order_cnt++] = key_size_bytes;
+    }
   }
 
-  int hash = ht->hash_function(key) % ht->hmax;
-  info *inside_data = &ht->buckets[hash];
+  return NULL;
+}
+
+/*
+ * Splits the input at line boundaries among no_threads workers and merges
+ * their counts into ht. The layout of a hashtable (and so the order of the
+ * output) only depends on the order in which new keys were added, so
+ * merging the keys of each worker in the order they first appeared, one
+ * worker after the other, gives exactly the same hashtable as reading the
+ * input on a single thread.
+ */
+void count_parallel(Hashtable *ht, Input *in, int no_threads) {
+  worker workers[MAX_THREADS];
+
+  size_t start = 0;
+  for (int i = 0; i < no_threads; i++) {
+    worker *w = &workers[i];
+    size_t end = in->size;
+    if (i + 1 < no_threads) {
+      end = next_line_start(in, in->size / no_threads * (i + 1));
+    }
+    if (end < start) {
+      end = start;
+    }
+
+    w->in = input_range(in, start, end);
+    start = end;
 
-  // Linear probing; if initial bucket was empty => while loop isn't accessed
-  while (inside_data->value &&
-         ht->compare_function(key, ht->buckets[hash].key)) {
-    hash = (hash + 1) % ht->hmax;
-    inside_data = &ht->buckets[hash];
+    w->ht = malloc(sizeof(Hashtable));
+    mem_check(w->ht);
+    init_ht(w->ht, INITIAL_HMAX, ht->hash_function, ht->compare_function,
+            ht->engine);
+    w->order = NULL;
+    w->order_len = NULL;
+    w->order_cnt = 0;
   }
 
-  // OLD STRING => updating count
-  if (inside_data->value) {
-    inside_data->value++;
-    return;
+  for (int i = 0; i < no_threads; i++) {
+    if (pthread_create(&workers[i].thread, NULL, count_range, &workers[i])) {
+      fprintf(stderr, "Couldn't start thread\n");
+      exit(ERROR_STATUS);
+    }
   }
 
-  // NEW STRING => initializing count
-  inside_data->key = malloc(key_size_bytes + 1);
-  snprintf(inside_data->key, key_size_bytes + 1, "%s", (char *)key);
-  inside_data->value = NEW_STRING_CNT;
+  // Merging, in input order
+  for (int i = 0; i < no_threads; i++) {
+    worker *w = &workers[i];
+    pthread_join(w->thread, NULL);
+
+    for (int j = 0; j < w->order_cnt; j++) {
+      info *src = find_bucket(w->ht, w->order[j], w->order_len[j]);
+      info *dst = find_bucket(ht, w->order[j], w->order_len[j]);
+      add_count(ht, dst, get_count(w->ht, src));
+    }
+
+    close_input(w->in);
+    free_ht(w->ht);
+    free(w->order);
+    free(w->order_len);
+  }
 }
 
-void free_ht(Hashtable *ht) {
-  if (ht == NULL) {
-    return;
+/*
+ * Counts the distinct keys by their 64-bit hashes. Two different keys are
+ * only counted once if their hashes are equal, which for n keys happens
+ * with probability about n^2 / 2^65 (less than 1e-7 for 1 million keys).
+ * That needs all 64 bits, so the set always gets wyhash (hash_bytes),
+ * whatever --hash says: djb2 only has 32. With several threads, each one
+ * fills its own set and the sets are merged at the end.
+ */
+size_t count_distinct(Input *in, int no_threads) {
+  set_worker workers[MAX_THREADS];
+
+  size_t start = 0;
+  for (int i = 0; i < no_threads; i++) {
+    set_worker *w = &workers[i];
+    size_t end = in->size;
+    if (i + 1 < no_threads) {
+      end = next_line_start(in, in->size / no_threads * (i + 1));
+    }
+    if (end < start) {
+      end = start;
+    }
+
+    // A single thread reads the input as it is (it may be a pipe)
+    w->in = no_threads > 1 ? input_range(in, start, end) : in;
+    start = end;
+    init_hash_set(&w->set, INITIAL_HMAX);
   }
 
-  for (int i = 0; i < ht->hmax; i++) {
-    free(ht->buckets[i].key);
+  if (no_threads == 1) {
+    distinct_range(&workers[0]);
+  } else {
+    for (int i = 0; i < no_threads; i++) {
+      if (pthread_create(&workers[i].thread, NULL, distinct_range,
+                         &workers[i])) {
+        fprintf(stderr, "Couldn't start thread\n");
+        exit(ERROR_STATUS);
+      }
+    }
+    for (int i = 0; i < no_threads; i++) {
+      pthread_join(workers[i].thread, NULL);
+      close_input(workers[i].in);
+      if (i) {
+        hash_set_union(&workers[0].set, &workers[i].set);
+        free_hash_set(&workers[i].set);
+      }
+    }
   }
 
-  free(ht->buckets);
-  free(ht);
+  size_t count = hash_set_count(&workers[0].set);
+  free_hash_set(&workers[0].set);
+  return count;
 }
 
-void mem_check(void *p) {
-  if (p == NULL) {
-    fprintf(stderr, "Error allocating memory\n");
-    exit(ERROR_STATUS);
+void *distinct_range(void *arg) {
+  set_worker *w = arg;
+  const char *key;
+  size_t key_size_bytes;
+
+  while (next_token(w->in, &key, &key_size_bytes)) {
+    hash_set_add(&w->set, hash_bytes(key, key_size_bytes));
+  }
+
+  return NULL;
+}
+
+/*
+ * Prints the (approximately) k most frequent keys, most frequent first.
+ * Counts are Count-Min estimates: never below the real ones, and equal
+ * to them as long as the sketch is wide enough for the input.
+ */
+void print_top(Input *in, hash_fn hash_function, int k, int cms_width,
+               int cms_depth) {
+  TopK top;
+  const char *key;
+  size_t key_size_bytes;
+
+  init_top_k(&top, k, hash_function, cms_width, cms_depth);
+  while (next_token(in, &key, &key_size_bytes)) {
+    top_k_add(&top, key, key_size_bytes);
+  }
+
+  const top_entry *entries = top_k_sorted(&top);
+  for (uint32_t i = 0; i < top.size; i++) {
+    printf("%s %" PRIu64 "\n", entries[i].key, entries[i].count);
+  }
+
+  free_top_k(&top);
+}
+
+/*
+ * Exact counts in bounded memory (hybrid hash aggregation): keys are
+ * counted in the hashtable as usual and, whenever it would outgrow
+ * mem_limit, its (key, count) pairs are appended to SPILL_FANOUT partition
+ * files by hash and the table starts over. At the end, every partition is
+ * counted on its own (spilling again, one level deeper, if it's still too
+ * big) and printed. If nothing was spilled, it's just the usual count.
+ * Files are only written and read sequentially.
+ */
+void count_limited(Input *in, hash_fn hash_function, int engine,
+                   size_t mem_limit) {
+  spill_ctx ctx = { hash_function, engine, mem_limit, NULL, 0 };
+
+  aggregate(&ctx, in, NULL, 0);
+  free(ctx.key);
+}
+
+// Counts the tokens of in (count 1 each) or the records of the file from
+void aggregate(spill_ctx *ctx, Input *in, FILE *from, int level) {
+  FILE *parts[SPILL_FANOUT] = { NULL };
+  int spilled = 0;
+
+  Hashtable *ht = malloc(sizeof(Hashtable));
+  mem_check(ht);
+  init_ht(ht, INITIAL_HMAX, ctx->hash_function, compare_function_strings,
+          ctx->engine);
+
+  while (1) {
+    const char *key;
+    size_t len;
+    uint64_t count = 1;
+
+    if (from == NULL) {
+      if (!next_token(in, &key, &len)) {
+        break;
+      }
+    } else {
+      uint32_t len32;
+      if (!spill_read(from, &ctx->key, &ctx->key_cap, &len32, &count)) {
+        break;
+      }
+      key = ctx->key;
+      len = len32;
+    }
+
+    // Full => everything goes to the partitions and the table is emptied
+    // (keeping its size, so it doesn't have to grow again)
+    if (level < SPILL_MAX_LEVEL && ht->size &&
+        ht_peak_memory(ht, len) > ctx->mem_limit) {
+      spill_table(ht, parts, level);
+      clear_ht(ht);
+      spilled = 1;
+    }
+
+    add_count(ht, find_bucket(ht, key, len), count);
+  }
+
+  if (!spilled) {
+    print_counts(ht);
+    free_ht(ht);
+    return;
+  }
+
+  spill_table(ht, parts, level);
+  free_ht(ht);
+
+  for (int i = 0; i < SPILL_FANOUT; i++) {
+    if (parts[i] != NULL) {
+      rewind(parts[i]);
+      aggregate(ctx, NULL, parts[i], level + 1);
+      fclose(parts[i]);
+    }
+  }
+}
+
+// Appends every key of ht, with its count, to its partition file
+void spill_table(Hashtable *ht, FILE **parts, int level) {
+  for (int i = 0; i < ht->hmax; i++) {
+    uint64_t count = get_count(ht, &ht->buckets[i]);
+    if (!count) {
+      continue;
+    }
+
+    info *bucket = &ht->buckets[i];
+    int part = spill_partition(bucket->hash, level);
+    if (parts[part] == NULL) {
+      parts[part] = open_spill_file();
+    }
+    spill_write(parts[part], bucket_key(bucket), bucket->key_len, count);
   }
 }
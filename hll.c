@@ -1,142 +1,576 @@
 // Copyright 2020 Radu-Stefan Minea 314CA
 
+#define _POSIX_C_SOURCE 200809L
+
+#include <inttypes.h>
+#include <math.h>
+#include <pthread.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "libs/hashing.h"
+#include "libs/hll_batch.h"
+#include "libs/hll_estimate.h"
+#include "libs/hll_file.h"
+#include "libs/hll_shared.h"
+#include "libs/hll_window.h"
+#include "libs/hll_sketch.h"
+#include "libs/input.h"
+#include "libs/utils.h"
+
+// The first PRECISION bits of a hash pick the bucket => 2^PRECISION buckets
+#define DEFAULT_PRECISION 11
+#define MAX_THREADS 256
+#define MAX_RECORD_WIDTH (1 << 20)
+
+/*
+ * What the input holds: integers (whitespace-separated), strings (any
+ * whitespace-separated tokens, like hash.c reads them) or raw binary
+ * records of width bytes each
+ */
+enum key_type { INT_KEYS, STRING_KEYS, BINARY_KEYS };
 
-#define ERROR_STATUS -1
-#define BITS_PER_BYTE 8
-#define NO_BUCKETS 2 << 11
-#define BUCKET_BITS 11
+typedef struct key_format {
+  int type;
+  size_t width;
+} key_format;
 
-typedef struct Hashtable {
-  int hmax;
-  unsigned int (*hash_function)(void *);
-} Hashtable;
+/*
+ * --window: the last length records or, if in_ms, the last length
+ * milliseconds (by arrival time); length == 0 => the whole input
+ */
+typedef struct window_spec {
+  uint64_t length;
+  int in_ms;
+} window_spec;
 
-void file_check(FILE *f);
-void init_ht(Hashtable *ht, int hmax, unsigned int (*hash_function)(void *));
-void mem_check(void *p);
-int my_max(int a, int b);
-unsigned int hash_function_int(void *a);
-int find_initial_zeros(int x, int no_bits_total, int no_bucket_bits);
+/*
+ * One worker of the parallel mode: adds the values of its range of the
+ * (mapped) input to its own registers, or straight to the shared ones
+ */
+typedef struct worker {
+  pthread_t thread;
+  Input *in;
+  Hll sketch;
+  HllShared *shared;  // NULL => sketch is used
+  key_format keys;
+} worker;
+
+void parse_registers(const char *name, int *layout, int *sparse);
+int parse_estimator(const char *name);
+key_format parse_keys(const char *name);
+window_spec parse_window(const char *text);
+void print_estimate(Hll *M, int estimator);
+void load_union(Hll *M, char **paths, int no_paths);
+int merge_sketches(int argc, char **argv);
+int estimate_sketches(int argc, char **argv);
+void count_stream(Hll *M, HllShared *shared, Input *in, key_format keys);
+void count_keys(Hll *M, HllShared *shared, Input *in, key_format keys);
+int next_key_hash(Input *in, key_format keys, uint64_t *hash);
+void stream_estimates(Hll *M, Input *in, key_format keys, window_spec window,
+                      uint64_t every, int estimator);
+void *count_range(void *arg);
+void count_parallel(Hll *M, Input *in, int no_threads, int use_shared,
+                    key_format keys);
 
 int main(int argc, char **argv) {
+  // Sketch files only, no input to read
+  if (argc > 1 && !strcmp(argv[1], "merge")) {
+    return merge_sketches(argc - 2, argv + 2);
+  }
+  if (argc > 1 && !strcmp(argv[1], "estimate")) {
+    return estimate_sketches(argc - 2, argv + 2);
+  }
+
+  int precision = DEFAULT_PRECISION;
+  int layout = HLL_PACKED, sparse = 1;
+  int estimator = HLL_ERTL;
+  const char *path = NULL;
+  const char *save_path = NULL;
+  int no_threads = 1, use_shared = 0;
+  key_format keys = { INT_KEYS, 0 };
+  window_spec window = { 0, 0 };
+  uint64_t every = 0;
+
   // 0) Checking command line paramaters
-  if (argc < 2) {
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "-p") && i + 1 < argc) {
+      precision = atoi(argv[++i]);
+    } else if (!strcmp(argv[i], "--registers") && i + 1 < argc) {
+      parse_registers(argv[++i], &layout, &sparse);
+    } else if (!strcmp(argv[i], "--estimator") && i + 1 < argc) {
+      estimator = parse_estimator(argv[++i]);
+    } else if (!strcmp(argv[i], "--save") && i + 1 < argc) {
+      save_path = argv[++i];
+    } else if (!strcmp(argv[i], "--threads") && i + 1 < argc) {
+      no_threads = atoi(argv[++i]);
+    } else if (!strcmp(argv[i], "--shared")) {
+      use_shared = 1;
+    } else if (!strcmp(argv[i], "--keys") && i + 1 < argc) {
+      keys = parse_keys(argv[++i]);
+    } else if (!strcmp(argv[i], "--window") && i + 1 < argc) {
+      window = parse_window(argv[++i]);
+    } else if (!strcmp(argv[i], "--every") && i + 1 < argc) {
+      every = strtoull(argv[++i], NULL, 10);
+    } else if ((argv[i][0] != '-' || !strcmp(argv[i], "-")) &&
+               path == NULL) {
+      path = argv[i];
+    } else {
+      fprintf(stderr,
+              "Usage: %s [-p precision] [--registers sparse|packed|dense] "
+              "[--estimator ertl|hllpp|raw] [--save sketch]\n"
+              "       [--threads N [--shared]] [--keys int|string|binary:N]"
+              "\n       [--window N[s|m|h] [--every K]] <input file | ->\n"
+              "       %s merge [--registers sparse|packed|dense] "
+              "<output sketch> <sketch>...\n"
+              "       %s estimate [--estimator ertl|hllpp|raw] <sketch>...\n",
+              argv[0], argv[0], argv[0]);
+      exit(ERROR_STATUS);
+    }
+  }
+
+  if (path == NULL) {
     fprintf(stderr, "Please enter input file\n");
     exit(ERROR_STATUS);
   }
 
-  if (argc > 2) {
-    fprintf(stderr, "Please enter only one input file\n");
+  if (precision < HLL_MIN_PRECISION || precision > HLL_MAX_PRECISION) {
+    fprintf(stderr, "Precision must be between %d and %d\n",
+            HLL_MIN_PRECISION, HLL_MAX_PRECISION);
     exit(ERROR_STATUS);
   }
 
-  FILE *in = fopen(argv[1], "r");
-  file_check(in);
+  if (no_threads < 1 || no_threads > MAX_THREADS) {
+    fprintf(stderr, "Number of threads must be between 1 and %d\n",
+            MAX_THREADS);
+    exit(ERROR_STATUS);
+  }
 
-  // 1) Initializing variables
-  int no_bits_total = sizeof(int) * BITS_PER_BYTE;
-  int bucket_no, zeros_cnt, x, hash;
-  int m = NO_BUCKETS;
-  int *M = calloc(m, sizeof(int));
-  mem_check(M);
+  int streaming = window.length || every;
+  if (streaming && (no_threads > 1 || save_path != NULL)) {
+    fprintf(stderr, "--window and --every can't be used with --threads or "
+            "--save\n");
+    exit(ERROR_STATUS);
+  }
+
+  // "-" => stdin
+  Input *in = open_input(strcmp(path, "-") ? path : NULL);
+
+  // Workers split the input among themselves => it has to be a file
+  if (no_threads > 1 && !in->mapped) {
+    fprintf(stderr, "--threads needs a regular file as input\n");
+    exit(ERROR_STATUS);
+  }
 
-  Hashtable *ht = malloc(sizeof(Hashtable));
-  mem_check(ht);
-  init_ht(ht, m, hash_function_int);
+  // 1) Initializing variables
+  // Sparse until it's worth storing every register, then 6 bits/register
+  Hll M;
+  init_hll(&M, precision, layout, sparse);
 
   // 2) Processing input
-  while (fscanf(in, "%d", &x) != EOF) {
-    hash = ht->hash_function(&x);
-    if (hash < 0) {
-      hash *= -1;
+  if (streaming) {
+    // Estimates are printed while reading
+    stream_estimates(&M, in, keys, window, every, estimator);
+    close_input(in);
+    free_hll(&M);
+    return 0;
+  }
+
+  if (no_threads > 1) {
+    count_parallel(&M, in, no_threads, use_shared, keys);
+    // Registers were merged one byte each
+    if (!sparse || M.layout != HLL_SPARSE) {
+      hll_convert(&M, layout);
+    }
+  } else {
+    count_stream(&M, NULL, in, keys);
+  }
+
+  // 3) + 4) Aggregating values and determining final answer
+  print_estimate(&M, estimator);
+
+  // The registers can be merged with other sketches later on
+  if (save_path != NULL) {
+    hll_save(&M, save_path);
+  }
+
+  close_input(in);
+  free_hll(&M);
+  return 0;
+}
+
+/*
+ * Values are added in batches (hashed several at once with SIMD); the whole
+ * 64-bit value is hashed to 64 bits, so collisions only start to matter far
+ * beyond 2^32 distinct values
+ */
+void count_stream(Hll *M, HllShared *shared, Input *in, key_format keys) {
+  if (keys.type != INT_KEYS) {
+    count_keys(M, shared, in, keys);
+    return;
+  }
+
+  int64_t values[HLL_BATCH_SIZE];
+  int no_values = 0;
+
+  while (1) {
+    int more = next_int(in, &values[no_values]);
+    no_values += more;
+
+    if (no_values == HLL_BATCH_SIZE || (!more && no_values)) {
+      if (shared != NULL) {
+        hll_shared_add_batch(shared, values, no_values);
+      } else {
+        hll_add_i64_batch(M, values, no_values);
+      }
+      no_values = 0;
     }
 
-    bucket_no = hash >> (no_bits_total - BUCKET_BITS);
-    zeros_cnt = find_initial_zeros(hash, no_bits_total, BUCKET_BITS);
-    M[bucket_no] = my_max(M[bucket_no], zeros_cnt);
+    if (!more) {
+      break;
+    }
   }
+}
 
-  // 3) Aggregating values
-  double z = 0;
-  int used_buckets = 0;
-  for (int i = 0; i < m; i++) {
-    if (M[i]) {
-      z += (double)1 / (2 << M[i]);
-      used_buckets++;
+// Strings and binary records, one by one
+void count_keys(Hll *M, HllShared *shared, Input *in, key_format keys) {
+  uint64_t hash;
+
+  while (next_key_hash(in, keys, &hash)) {
+    if (shared != NULL) {
+      hll_shared_add_hash(shared, hash);
+    } else {
+      hll_add_hash(M, hash);
     }
   }
-  z = 1 / z;
+}
 
-  // m becomes the number of used buckets
-  m = used_buckets;
+/*
+ * Hash of the next key: integers go through hash_u64, strings and binary
+ * records through the 64-bit wyhash
+ */
+int next_key_hash(Input *in, key_format keys, uint64_t *hash) {
+  const char *key;
+  size_t len = keys.width;
+  int64_t value;
 
-  // 4) Determining final answer
-  int E;
-  double alpha = (double)0.7213 / (1 + (double)1.079 / m);
-  E = alpha * (m * m) * z;
+  switch (keys.type) {
+    case INT_KEYS:
+      if (!next_int(in, &value)) {
+        return 0;
+      }
+      *hash = hash_u64((uint64_t)value);
+      return 1;
+    case STRING_KEYS:
+      if (!next_token(in, &key, &len)) {
+        return 0;
+      }
+      break;
+    default:
+      if (!next_record(in, keys.width, &key)) {
+        return 0;
+      }
+  }
 
-  printf("%d\n", E);
+  *hash = wyhash(key, len);
+  return 1;
+}
 
-  fclose(in);
-  free(M);
-  free(ht);
-  return 0;
+static uint64_t now_ms(void) {
+  struct timespec t;
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return (uint64_t)t.tv_sec * 1000 + t.tv_nsec / 1000000;
 }
 
-void file_check(FILE *f) {
-  if (f == NULL) {
-    fprintf(stderr, "Couldn't open input file\n");
-    exit(ERROR_STATUS);
+/*
+ * Streaming mode: reads one key at a time and, every `every` records (and
+ * at the end), prints "<records read> <estimate>": of the whole input so
+ * far or, with a window, of its last part. Without --every only the final
+ * estimate is printed.
+ */
+void stream_estimates(Hll *M, Input *in, key_format keys, window_spec window,
+                      uint64_t every, int estimator) {
+  HllWindow W;
+  uint64_t hist[HLL_MAX_RANK + 1];
+  uint64_t hash, records = 0, now = 0;
+
+  if (window.length) {
+    init_hll_window(&W, M->precision, window.length);
+  }
+
+  while (1) {
+    int more = next_key_hash(in, keys, &hash);
+    if (more) {
+      records++;
+      now = window.in_ms ? now_ms() : records;
+      if (window.length) {
+        hll_window_add_hash(&W, hash, now);
+      } else {
+        hll_add_hash(M, hash);
+      }
+    }
+
+    // Reporting every `every` records, and once at the end (unless the
+    // last report was on the last record; an empty stream still gets one)
+    if (more ? every && records % every == 0
+             : !every || records % every || records == 0) {
+      if (window.length) {
+        // A time window also ends now, not at the last record
+        if (window.in_ms) {
+          now = now_ms();
+        }
+        hll_window_histogram(&W, now, window.length, hist);
+      } else {
+        hll_histogram(M, hist);
+      }
+
+      int64_t E = llround(hll_estimate(hist, M->precision, estimator));
+      if (every) {
+        printf("%" PRIu64 " ", records);
+      }
+      printf("%" PRId64 "\n", E);
+      fflush(stdout);
+    }
+
+    if (!more) {
+      break;
+    }
+  }
+
+  if (window.length) {
+    free_hll_window(&W);
   }
 }
 
-void init_ht(Hashtable *ht, int hmax, unsigned int (*hash_function)(void *)) {
-  if (ht == NULL) {
-    return;
+void *count_range(void *arg) {
+  worker *w = arg;
+
+  count_stream(&w->sketch, w->shared, w->in, w->keys);
+  return NULL;
+}
+
+/*
+ * Splits the input at line boundaries (record boundaries, for binary
+ * records) among no_threads workers. Each one
+ * fills its own registers, merged into M at the end by taking the maximum,
+ * or (use_shared) they all raise the same registers with atomic fetch-max.
+ */
+void count_parallel(Hll *M, Input *in, int no_threads, int use_shared,
+                    key_format keys) {
+  worker workers[MAX_THREADS];
+  HllShared shared;
+
+  if (use_shared) {
+    init_hll_shared(&shared, M->precision);
+  }
+
+  size_t start = 0;
+  for (int i = 0; i < no_threads; i++) {
+    worker *w = &workers[i];
+    size_t end = in->size;
+    if (i + 1 < no_threads) {
+      end = in->size / no_threads * (i + 1);
+      if (keys.type == BINARY_KEYS) {
+        end -= end % keys.width;
+      } else {
+        end = next_line_start(in, end);
+      }
+    }
+    if (end < start) {
+      end = start;
+    }
+
+    w->in = input_range(in, start, end);
+    start = end;
+
+    w->shared = use_shared ? &shared : NULL;
+    w->keys = keys;
+    // Small ranges stay sparse, so a small union can stay sparse too
+    if (!use_shared) {
+      init_hll(&w->sketch, M->precision, HLL_DENSE, M->layout == HLL_SPARSE);
+    }
+  }
+
+  for (int i = 0; i < no_threads; i++) {
+    if (pthread_create(&workers[i].thread, NULL, count_range, &workers[i])) {
+      fprintf(stderr, "Couldn't start thread\n");
+      exit(ERROR_STATUS);
+    }
+  }
+
+  // Merging; max doesn't depend on the order
+  for (int i = 0; i < no_threads; i++) {
+    worker *w = &workers[i];
+    pthread_join(w->thread, NULL);
+
+    if (!use_shared) {
+      hll_merge(M, &w->sketch);
+      free_hll(&w->sketch);
+    }
+    close_input(w->in);
   }
 
-  ht->hmax = hmax;
-  ht->hash_function = hash_function;
+  if (use_shared) {
+    hll_shared_merge(&shared, M);
+    free_hll_shared(&shared);
+  }
+}
+
+void print_estimate(Hll *M, int estimator) {
+  // hist[r] = number of buckets of rank r
+  uint64_t hist[HLL_MAX_RANK + 1];
+  hll_histogram(M, hist);
+
+  // From every bucket (empty ones included)
+  int64_t E = llround(hll_estimate(hist, M->precision, estimator));
+
+  printf("%" PRId64 "\n", E);
+}
+
+// M = union of the sketch files (all of the same precision)
+void load_union(Hll *M, char **paths, int no_paths) {
+  hll_load(M, paths[0]);
+
+  for (int i = 1; i < no_paths; i++) {
+    Hll other;
+    hll_load(&other, paths[i]);
+    if (other.precision != M->precision) {
+      fprintf(stderr, "Sketches of different precisions: %s (%d), %s (%d)\n",
+              paths[0], M->precision, paths[i], other.precision);
+      exit(ERROR_STATUS);
+    }
+
+    hll_merge(M, &other);
+    free_hll(&other);
+  }
 }
 
-void mem_check(void *p) {
-  if (p == NULL) {
-    fprintf(stderr, "Error allocating memory\n");
+int merge_sketches(int argc, char **argv) {
+  int layout = HLL_PACKED, sparse = 1;
+
+  if (argc >= 2 && !strcmp(argv[0], "--registers")) {
+    parse_registers(argv[1], &layout, &sparse);
+    argc -= 2;
+    argv += 2;
+  }
+
+  if (argc < 2) {
+    fprintf(stderr, "Usage: hll merge [--registers sparse|packed|dense] "
+            "<output sketch> <sketch>...\n");
     exit(ERROR_STATUS);
   }
+
+  Hll M;
+  load_union(&M, argv + 1, argc - 1);
+
+  // A union of small sparse sketches may still be sparse
+  if (!sparse || M.layout != HLL_SPARSE) {
+    hll_convert(&M, layout);
+  }
+  hll_save(&M, argv[0]);
+
+  free_hll(&M);
+  return 0;
 }
 
-int my_max(int a, int b) {
-  if (a > b) {
-    return a;
+int estimate_sketches(int argc, char **argv) {
+  int estimator = HLL_ERTL;
+
+  if (argc >= 2 && !strcmp(argv[0], "--estimator")) {
+    estimator = parse_estimator(argv[1]);
+    argc -= 2;
+    argv += 2;
+  }
+
+  if (argc < 1) {
+    fprintf(stderr,
+            "Usage: hll estimate [--estimator ertl|hllpp|raw] <sketch>...\n");
+    exit(ERROR_STATUS);
   }
-  return b;
+
+  Hll M;
+  load_union(&M, argv, argc);
+  print_estimate(&M, estimator);
+
+  free_hll(&M);
+  return 0;
 }
 
-unsigned int hash_function_int(void *a) {
-  /*
-   * Credits: https://stackoverflow.com/a/12996028/7883884
-   */
-  unsigned int uint_a = *((unsigned int *)a);
+window_spec parse_window(const char *text) {
+  window_spec window = { 0, 0 };
+  char *unit;
+
+  window.length = strtoull(text, &unit, 10);
+  if (*unit) {
+    window.in_ms = 1;
+    if (!strcmp(unit, "s")) {
+      window.length *= 1000;
+    } else if (!strcmp(unit, "m")) {
+      window.length *= 60 * 1000;
+    } else if (!strcmp(unit, "h")) {
+      window.length *= 60 * 60 * 1000;
+    } else {
+      window.length = 0;
+    }
+  }
 
-  uint_a = ((uint_a >> 16u) ^ uint_a) * 0x45d9f3b;
-  uint_a = ((uint_a >> 16u) ^ uint_a) * 0x45d9f3b;
-  uint_a = (uint_a >> 16u) ^ uint_a;
-  return uint_a;
+  if (window.length == 0 || unit == text) {
+    fprintf(stderr, "Invalid window: %s (records, or a time ending in s, m "
+            "or h)\n", text);
+    exit(ERROR_STATUS);
+  }
+  return window;
 }
 
-int find_initial_zeros(int x, int no_bits_total, int no_bucket_bits) {
-  int cnt = 0;
+key_format parse_keys(const char *name) {
+  key_format keys = { INT_KEYS, 0 };
 
-  for (int i = no_bits_total - no_bucket_bits - 1; i >= 0; i--) {
-    int aux = x >> i;
-    if (aux % 2) {
-      break;
+  if (!strcmp(name, "string")) {
+    keys.type = STRING_KEYS;
+  } else if (!strncmp(name, "binary:", strlen("binary:"))) {
+    keys.type = BINARY_KEYS;
+    keys.width = atoi(name + strlen("binary:"));
+    if (keys.width < 1 || keys.width > MAX_RECORD_WIDTH) {
+      fprintf(stderr, "Record width must be between 1 and %d\n",
+              MAX_RECORD_WIDTH);
+      exit(ERROR_STATUS);
     }
-    cnt++;
+  } else if (strcmp(name, "int")) {
+    fprintf(stderr, "Unknown key type: %s\n", name);
+    exit(ERROR_STATUS);
+  }
+
+  return keys;
+}
+
+int parse_estimator(const char *name) {
+  if (!strcmp(name, "ertl")) {
+    return HLL_ERTL;
+  }
+  if (!strcmp(name, "hllpp")) {
+    return HLL_PLUS_PLUS;
+  }
+  if (!strcmp(name, "raw")) {
+    return HLL_RAW;
+  }
+
+  fprintf(stderr, "Unknown estimator: %s\n", name);
+  exit(ERROR_STATUS);
+}
+
+void parse_registers(const char *name, int *layout, int *sparse) {
+  *sparse = !strcmp(name, "sparse");
+  if (*sparse || !strcmp(name, "packed")) {
+    *layout = HLL_PACKED;
+    return;
+  }
+  if (!strcmp(name, "dense")) {
+    *layout = HLL_DENSE;
+    return;
   }
 
-  return cnt;
+  fprintf(stderr, "Unknown register layout: %s\n", name);
+  exit(ERROR_STATUS);
 }
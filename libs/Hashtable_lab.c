@@ -7,7 +7,9 @@
 #include <stdlib.h>
 #include <string.h>
 
-#include "Hashtable.h"
+#include "Hashtable_lab.h"
+#include "hashing.h"
+#include "utils.h"
 
 /*
  * Functii de comparare a cheilor:
@@ -49,38 +51,179 @@ unsigned int hash_function_int(void *a) {
 
 unsigned int hash_function_string(void *a) {
     /*
-     * Credits: http://www.cse.yorku.ca/~oz/hash.html
+     * wyhash (vezi hashing.c), impaturit pe 32 de biti
      */
-    unsigned char *puchar_a = (unsigned char*) a;
-    unsigned long hash = 5381;
-    int c;
+    uint64_t hash = hash_bytes(a, strlen((char *)a));
 
-    while ((c = *puchar_a++))
-        hash = ((hash << 5u) + hash) + c; /* hash * 33 + c */
+    return (unsigned int)(hash ^ (hash >> 32));
+}
+
+/*
+ * Aloca un array de hmax liste inlantuite goale. O lista plina de zero-uri
+ * e exact ce lasa init_list (head = NULL, size = 0), asa ca e folosit
+ * calloc: paginile noi vin deja zero de la kernel, deci o dublare nu mai
+ * trebuie sa treaca prin tot array-ul dintr-odata.
+ */
+static struct LinkedList *alloc_buckets(int hmax) {
+    struct LinkedList *buckets = calloc(hmax, sizeof(struct LinkedList));
+    mem_check(buckets);
 
-    return hash;
+    return buckets;
 }
 
 /*
  * Functie apelata dupa alocarea unui hashtable pentru a-l initializa.
  * Trebuie alocate si initializate si listele inlantuite.
+ * hmax e doar numarul initial de bucket-uri: hashtable-ul creste singur.
  */
 void init_ht(struct Hashtable *ht, int hmax, unsigned int (*hash_function)(void*), int (*compare_function)(void*, void*)) {
     if (ht == NULL) {
         return;
     }
- \
+
     // Initializarea hashtable
     ht->size = 0;
-    ht->hmax = hmax; // Obs: se da dinainte cate hash-uri/bucket-uri o sa avem
+    ht->hmax = hmax > 0 ? hmax : 1;
     ht->hash_function = hash_function;
     ht->compare_function = compare_function;
 
     // Alocarea si initialziarea listelor inlantuite
-    ht->buckets = malloc(hmax * sizeof(struct LinkedList));
-    for (int i = 0; i < hmax; i++) {
-        init_list(&ht->buckets[i]);
+    ht->buckets = alloc_buckets(ht->hmax);
+
+    ht->old_buckets = NULL;
+    ht->old_hmax = 0;
+    ht->rehash_pos = 0;
+
+    ht->blocks = NULL;
+    ht->block_used = HT_POOL_BLOCK;
+    ht->free_entries = NULL;
+}
+
+/*
+ * Pool-ul de intrari: o intrare eliberata e refolosita de urmatorul put,
+ * iar altfel se ia urmatoarea din blocul curent (un malloc la
+ * HT_POOL_BLOCK intrari, in loc de doua pentru fiecare intrare).
+ */
+static struct ht_entry *alloc_entry(struct Hashtable *ht) {
+    struct ht_entry *entry = ht->free_entries;
+
+    if (entry != NULL) {
+        ht->free_entries = (struct ht_entry *)entry->node.next;
+        return entry;
+    }
+
+    if (ht->block_used == HT_POOL_BLOCK) {
+        struct ht_block *block = malloc(sizeof(struct ht_block));
+        mem_check(block);
+        block->next = ht->blocks;
+        ht->blocks = block;
+        ht->block_used = 0;
     }
+
+    return &ht->blocks->entries[ht->block_used++];
+}
+
+static void release_entry(struct Hashtable *ht, struct ht_entry *entry) {
+    entry->node.next = (struct Node *)ht->free_entries;
+    ht->free_entries = entry;
+}
+
+/*
+ * Nodurile sunt legate direct, la inceputul listei (O(1)), fara
+ * add_nth_node/remove_nth_node, care ar aloca/elibera nodul.
+ */
+static void push_node(struct LinkedList *bucket, struct Node *node) {
+    node->next = bucket->head;
+    bucket->head = node;
+    bucket->size++;
+}
+
+/*
+ * Muta bucket-ul vechi rehash_pos (toate nodurile lui) in array-ul nou.
+ * Nodurile nu sunt realocate, doar legate in alta lista.
+ */
+static void migrate_bucket(struct Hashtable *ht) {
+    struct LinkedList *old = &ht->old_buckets[ht->rehash_pos++];
+    struct Node *it = old->head;
+
+    while (it != NULL) {
+        struct Node *next = it->next;
+        struct info *inside_data = (struct info *)it->data;
+        int hash = ht->hash_function(inside_data->key) % ht->hmax;
+
+        push_node(&ht->buckets[hash], it);
+        it = next;
+    }
+    init_list(old);
+
+    if (ht->rehash_pos == ht->old_hmax) {
+        free(ht->old_buckets);
+        ht->old_buckets = NULL;
+        ht->old_hmax = 0;
+        ht->rehash_pos = 0;
+    }
+}
+
+/*
+ * Redimensionare incrementala: in loc sa mute toate intrarile deodata
+ * (o pauza lunga la un singur put), fiecare operatie muta cate
+ * HT_REHASH_STEP bucket-uri vechi. Pana se termina, cheile pot fi in
+ * oricare dintre cele doua array-uri.
+ */
+static void rehash_step(struct Hashtable *ht) {
+    for (int i = 0; i < HT_REHASH_STEP && ht->old_buckets != NULL; i++) {
+        migrate_bucket(ht);
+    }
+}
+
+static void grow_ht(struct Hashtable *ht) {
+    // O redimensionare anterioara neterminata e terminata acum
+    while (ht->old_buckets != NULL) {
+        migrate_bucket(ht);
+    }
+
+    ht->old_buckets = ht->buckets;
+    ht->old_hmax = ht->hmax;
+    ht->rehash_pos = 0;
+
+    ht->hmax *= 2;
+    ht->buckets = alloc_buckets(ht->hmax);
+}
+
+/*
+ * Bucket-ul in care se afla acum cheia: in array-ul vechi daca bucket-ul
+ * ei de acolo n-a fost inca mutat, altfel in cel nou.
+ */
+static struct LinkedList *find_bucket(struct Hashtable *ht, void *key) {
+    unsigned int hash = ht->hash_function(key);
+
+    if (ht->old_buckets != NULL) {
+        int old_pos = hash % ht->old_hmax;
+        if (old_pos >= ht->rehash_pos) {
+            return &ht->old_buckets[old_pos];
+        }
+    }
+    return &ht->buckets[hash % ht->hmax];
+}
+
+/*
+ * Nodul cu cheia key din bucket (NULL daca nu e); in *prev ramane nodul
+ * dinaintea lui, pentru stergere.
+ */
+static struct Node *find_node(struct Hashtable *ht, struct LinkedList *bucket, void *key, struct Node **prev) {
+    struct Node *it = bucket->head;
+
+    *prev = NULL;
+    while (it != NULL) {
+        struct info *inside_data = (struct info *)it->data;
+        // Key match
+        if (ht->compare_function(inside_data->key, key) == 0) {
+            return it;
+        }
+        *prev = it;
+        it = it->next;
+    }
+    return NULL;
 }
 
 /*
@@ -110,55 +253,45 @@ void put(struct Hashtable *ht, void *key, int key_size_bytes, void *value) {
         return;
     }
 
-    // Gasim hash-ul : hash(key) % dictionary_size
-    int hash = ht->hash_function(key) % ht->hmax;
-    struct LinkedList *bucket = &ht->buckets[hash];
+    rehash_step(ht);
 
-    // Trebuie parcursa toata lista pana la capatul ei pana gasim keymatch
-    struct Node *it = bucket->head;
-    while (it != NULL) {
-        struct info *inside_data = (struct info *)it->data;
-        // Key match
-        if (ht->compare_function(inside_data->key, key) == 0) {
-            // Elementul e deja acolo => update (daca e deja updatat, operatia e degeaba)
-            inside_data->value = value;
-            return;
-            }
-    it = it->next;
+    struct Node *prev;
+    struct Node *it = find_node(ht, find_bucket(ht, key), key, &prev);
+    if (it != NULL) {
+        // Elementul e deja acolo => update (daca e deja updatat, operatia e degeaba)
+        ((struct info *)it->data)->value = value;
+        return;
     }
 
-    struct info *data = malloc(sizeof(struct info));
-    data->key = malloc(key_size_bytes); //  UNFREED!
-    memcpy(data->key, key, key_size_bytes);
-    data->value = value;
+    // Peste gradul de incarcare => incepe dublarea (mutarea se face treptat)
+    if (ht->size + 1 > HT_MAX_LOAD * ht->hmax) {
+        grow_ht(ht);
+    }
 
-    // Add/chain => bascially appending to the current bucket
-    add_nth_node(bucket, bucket->size, data);
+    struct ht_entry *entry = alloc_entry(ht);
+    entry->info.key = malloc(key_size_bytes);
+    mem_check(entry->info.key);
+    memcpy(entry->info.key, key, key_size_bytes);
+    entry->info.value = value;
+    entry->node.data = &entry->info;
+
+    // Acolo unde o vor cauta get/has_key (poate in array-ul vechi, de unde
+    // va fi mutata impreuna cu restul bucket-ului)
+    push_node(find_bucket(ht, key), &entry->node);
+    ht->size++;
 }
 
-/*
- * With "bucket" auxiliary 
- */
-
 void* get(struct Hashtable *ht, void *key) {
     if (ht == NULL) {
         return NULL;
     }
 
-    int hash = ht->hash_function(key) % ht->hmax;
-    struct LinkedList *bucket = &ht->buckets[hash];
+    rehash_step(ht);
 
-    struct Node *it = bucket->head;
-    while (it != NULL) {
-        struct info *inside_data = (struct info *)it->data;
-        // Key match
-        if (ht->compare_function(inside_data->key, key) == 0) {
-            return inside_data->value;
-            }
-    it = it->next;
-    }
+    struct Node *prev;
+    struct Node *it = find_node(ht, find_bucket(ht, key), key, &prev);
 
-    return NULL;
+    return it != NULL ? ((struct info *)it->data)->value : NULL;
 }
 
 /*
@@ -171,27 +304,17 @@ int has_key(struct Hashtable *ht, void *key) {
         return -1;
     }
 
-    int hash = ht->hash_function(key) % ht->hmax;
-    struct LinkedList *bucket = &ht->buckets[hash];
+    rehash_step(ht);
 
-    struct Node *it = bucket->head;
-    while (it != NULL) {
-        struct info *inside_data = (struct info *)it->data;
-        // Key match
-        if (ht->compare_function(inside_data->key, key) == 0) {
-            return 1;
-            }
-    it = it->next;
-    }
-
-    return 0;
+    struct Node *prev;
+    return find_node(ht, find_bucket(ht, key), key, &prev) != NULL;
 }
 
 /*
  * Procedura care elimina din hashtable intrarea asociata cheii key.
  * Atentie! Trebuie avuta grija la eliberarea intregii memorii folosite pentru o intrare din hashtable (adica memoria
  * pentru copia lui key --vezi observatia de la procedura put--, pentru structura info si pentru structura Node din
- * lista inlantuita).
+ * lista inlantuita). Nodul si info-ul se intorc in pool.
  */
 void remove_ht_entry(struct Hashtable *ht, void *key) {
     // Rudimentary checks
@@ -199,34 +322,33 @@ void remove_ht_entry(struct Hashtable *ht, void *key) {
         return;
     }
 
-    // Gasim hash-ul : hash(key) % dictionary_size
-    int hash = ht->hash_function(key) % ht->hmax;
-    struct LinkedList *bucket = &ht->buckets[hash];
+    rehash_step(ht);
 
-    struct Node *rmvd_node;
-    int pos = 0;
+    struct LinkedList *bucket = find_bucket(ht, key);
+    struct Node *prev;
+    struct Node *it = find_node(ht, bucket, key, &prev);
+    if (it == NULL) {
+        return;
+    }
 
-    // Trebuie parcursa toata lista pana la capatul ei pana gasim keymatch
-    struct Node *it = bucket->head;
-    while (it != NULL) {
-        struct info *inside_data = (struct info *)it->data;
-        // Key match
-        if (ht->compare_function(inside_data->key, key) == 0) {
-            rmvd_node = remove_nth_node(bucket, pos);
-            free(inside_data->key);
-            free(inside_data);
-            free(rmvd_node);
-            return;
-            }
-    it = it->next;
-    pos++;
+    if (prev == NULL) {
+        bucket->head = it->next;
+    } else {
+        prev->next = it->next;
     }
-    
+    bucket->size--;
+    ht->size--;
+
+    struct ht_entry *entry = (struct ht_entry *)it;
+    free(entry->info.key);
+    release_entry(ht, entry);
 }
 
 /*
  * Procedura care elibereaza memoria folosita de toate intrarile din hashtable, dupa care elibereaza si memoria folosita
  * pentru a stoca structura hashtable.
+ * Bucket-urile sunt elemente ale unui array, nu liste alocate separat, deci nu li se aplica free_list; nodurile
+ * sunt eliberate odata cu blocurile pool-ului.
  */
 void free_ht(struct Hashtable *ht) {
     if (ht == NULL) {
@@ -234,20 +356,25 @@ void free_ht(struct Hashtable *ht) {
     }
 
     for (int i = 0; i < ht->hmax; i++) {
-        struct LinkedList *bucket = &ht->buckets[i];
-        struct Node *it = bucket->head;
-        
-        while (it != NULL) {
-            struct info *inside_data = (struct info *)it->data;
-            free(inside_data->key);
-            free(inside_data);
-            it = it->next;
+        for (struct Node *it = ht->buckets[i].head; it != NULL; it = it->next) {
+            free(((struct info *)it->data)->key);
         }
-        free_list(bucket);
     }
+    for (int i = ht->rehash_pos; i < ht->old_hmax; i++) {
+        for (struct Node *it = ht->old_buckets[i].head; it != NULL; it = it->next) {
+            free(((struct info *)it->data)->key);
+        }
+    }
+
+    while (ht->blocks != NULL) {
+        struct ht_block *next = ht->blocks->next;
+        free(ht->blocks);
+        ht->blocks = next;
+    }
+
     free(ht->buckets);
+    free(ht->old_buckets);
     free(ht);
-
 }
 
 int get_ht_size(struct Hashtable *ht) {
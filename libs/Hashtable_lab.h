@@ -7,15 +7,53 @@
 
 #include "LinkedList.h"
 
+/*
+ * Gradul de incarcare (size / hmax) peste care hashtable-ul isi dubleaza
+ * numarul de bucket-uri.
+ */
+#define HT_MAX_LOAD 1
+/*
+ * Cate bucket-uri vechi sunt mutate in noul array la fiecare operatie, cat
+ * timp dureaza o redimensionare.
+ */
+#define HT_REHASH_STEP 4
+/* Cate intrari sunt alocate deodata (un singur malloc). */
+#define HT_POOL_BLOCK 256
+
 struct info {
     void *key;
     void *value;
 };
 
+/*
+ * Nodul din lista si datele lui, alocate impreuna, din blocuri de cate
+ * HT_POOL_BLOCK (node.data == &info).
+ */
+struct ht_entry {
+    struct Node node;
+    struct info info;
+};
+
+struct ht_block {
+    struct ht_block *next;
+    struct ht_entry entries[HT_POOL_BLOCK];
+};
+
 struct Hashtable {
     struct LinkedList *buckets; /* Array de liste simplu-inlantuite. */
     int size; /* Nr. total de noduri existente curent in toate bucket-urile. */
     int hmax; /* Nr. de bucket-uri. */
+    /*
+     * In timpul unei redimensionari: array-ul vechi, din care bucket-urile
+     * [0, rehash_pos) au fost deja mutate. NULL in rest.
+     */
+    struct LinkedList *old_buckets;
+    int old_hmax;
+    int rehash_pos;
+    /* Pool-ul de intrari: blocurile alocate si intrarile eliberate. */
+    struct ht_block *blocks;
+    int block_used; /* Intrari folosite din primul bloc. */
+    struct ht_entry *free_entries; /* Legate prin node.next. */
     /* (Pointer la) Functie pentru a calcula valoarea hash asociata cheilor. */
     unsigned int (*hash_function)(void*);
     /* (Pointer la) Functie pentru a compara doua chei. */
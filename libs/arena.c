@@ -0,0 +1,79 @@
+// Copyright 2020 Radu-Stefan Minea 314CA
+
+#include "libs/arena.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+void init_arena(Arena *arena, size_t chunk_size) {
+  if (arena == NULL) {
+    return;
+  }
+
+  arena->head = NULL;
+  arena->chunk_size = chunk_size;
+  arena->allocated = 0;
+}
+
+void *arena_alloc(Arena *arena, size_t size) {
+  if (arena == NULL) {
+    return NULL;
+  }
+
+  arena_chunk *chunk = arena->head;
+
+  // Current chunk is full (or the request is too big for any regular chunk)
+  // => starting a new one
+  if (chunk == NULL || chunk->cap - chunk->used < size) {
+    size_t cap = size > arena->chunk_size ? size : arena->chunk_size;
+
+    chunk = malloc(sizeof(arena_chunk) + cap);
+    if (chunk == NULL) {
+      return NULL;
+    }
+
+    chunk->used = 0;
+    chunk->cap = cap;
+    arena->allocated += sizeof(arena_chunk) + cap;
+
+    // Oversized chunks go behind the head, so the free space left in the
+    // current chunk is still used by the next (small) requests
+    if (cap > arena->chunk_size && arena->head != NULL) {
+      chunk->next = arena->head->next;
+      arena->head->next = chunk;
+    } else {
+      chunk->next = arena->head;
+      arena->head = chunk;
+    }
+  }
+  void *p = chunk->data + chunk->used;
+  chunk->used += size;
+  return p;
+}
+
+char *arena_strndup(Arena *arena, const char *str, size_t len) {
+  char *copy = arena_alloc(arena, len + 1);
+  if (copy == NULL) {
+    return NULL;
+  }
+
+  memcpy(copy, str, len);
+  copy[len] = '\0';
+  return copy;
+}
+
+void free_arena(Arena *arena) {
+  if (arena == NULL) {
+    return;
+  }
+
+  arena_chunk *chunk = arena->head;
+  while (chunk != NULL) {
+    arena_chunk *next = chunk->next;
+    free(chunk);
+    chunk = next;
+  }
+
+  arena->head = NULL;
+  arena->allocated = 0;
+}
@@ -0,0 +1,34 @@
+// Copyright 2020 Radu-Stefan Minea 314CA
+
+#ifndef LIBS_ARENA_H_
+#define LIBS_ARENA_H_
+
+#include <stddef.h>
+
+#define ARENA_CHUNK_SIZE (1 << 16)
+
+/*
+ * Bump allocator: memory is handed out from big chunks and is only given
+ * back all at once, by free_arena(). Pointers stay valid until then.
+ * Nothing is aligned, since the arena only stores strings.
+ */
+typedef struct arena_chunk {
+  struct arena_chunk *next;
+  size_t used;
+  size_t cap;
+  char data[];
+} arena_chunk;
+
+typedef struct Arena {
+  arena_chunk *head;
+  size_t chunk_size;
+  size_t allocated;  // Bytes of all the chunks together
+} Arena;
+
+void init_arena(Arena *arena, size_t chunk_size);
+// Both return NULL if memory couldn't be allocated
+void *arena_alloc(Arena *arena, size_t size);
+char *arena_strndup(Arena *arena, const char *str, size_t len);
+void free_arena(Arena *arena);
+
+#endif  // LIBS_ARENA_H_
@@ -0,0 +1,84 @@
+// Copyright 2020 Radu-Stefan Minea 314CA
+
+#include "libs/count_min.h"
+
+#include <stdlib.h>
+
+#include "libs/hashing.h"
+#include "libs/utils.h"
+
+void init_count_min(CountMin *cms, uint32_t width, uint32_t depth) {
+  if (cms == NULL) {
+    return;
+  }
+
+  uint32_t pow2 = 1;
+  while (pow2 < width) {
+    pow2 <<= 1;
+  }
+
+  cms->width = pow2;
+  cms->depth = depth < CMS_MAX_DEPTH ? depth : CMS_MAX_DEPTH;
+  cms->counts = calloc((size_t)cms->width * cms->depth, sizeof(uint32_t));
+  mem_check(cms->counts);
+}
+
+/*
+ * Counter of the key in every row: row i uses h1 + i * h2, where h2 is odd,
+ * so the rows behave like independent hash functions
+ */
+static void positions(const CountMin *cms, uint64_t hash, size_t *pos) {
+  uint64_t h2 = hash_u64(hash) | 1;
+  uint32_t mask = cms->width - 1;
+
+  for (uint32_t i = 0; i < cms->depth; i++) {
+    pos[i] = (size_t)i * cms->width + ((hash + i * h2) & mask);
+  }
+}
+
+uint64_t count_min_add(CountMin *cms, uint64_t hash, uint32_t n) {
+  size_t pos[CMS_MAX_DEPTH];
+  positions(cms, hash, pos);
+
+  uint64_t estimate = UINT32_MAX;
+  for (uint32_t i = 0; i < cms->depth; i++) {
+    if (cms->counts[pos[i]] < estimate) {
+      estimate = cms->counts[pos[i]];
+    }
+  }
+
+  // Conservative update: no counter goes above the new estimate
+  estimate += n;
+  if (estimate > UINT32_MAX) {
+    estimate = UINT32_MAX;
+  }
+  for (uint32_t i = 0; i < cms->depth; i++) {
+    if (cms->counts[pos[i]] < estimate) {
+      cms->counts[pos[i]] = estimate;
+    }
+  }
+
+  return estimate;
+}
+
+uint64_t count_min_estimate(const CountMin *cms, uint64_t hash) {
+  size_t pos[CMS_MAX_DEPTH];
+  positions(cms, hash, pos);
+
+  uint64_t estimate = UINT32_MAX;
+  for (uint32_t i = 0; i < cms->depth; i++) {
+    if (cms->counts[pos[i]] < estimate) {
+      estimate = cms->counts[pos[i]];
+    }
+  }
+  return estimate;
+}
+
+void free_count_min(CountMin *cms) {
+  if (cms == NULL) {
+    return;
+  }
+
+  free(cms->counts);
+  cms->counts = NULL;
+}
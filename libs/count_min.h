@@ -0,0 +1,32 @@
+// Copyright 2020 Radu-Stefan Minea 314CA
+
+#ifndef LIBS_COUNT_MIN_H_
+#define LIBS_COUNT_MIN_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define CMS_MAX_DEPTH 32
+
+/*
+ * Count-Min Sketch: depth rows of width counters; a key adds to one counter
+ * per row and its estimate is the smallest of them, which is never below
+ * its real count. With conservative update, a counter is only raised as
+ * far as the new estimate, so keys sharing a counter inflate each other a
+ * lot less. The row positions of a key come from its 64-bit hash (double
+ * hashing), so the key itself is never stored.
+ */
+typedef struct CountMin {
+  uint32_t width;  // Power of 2
+  uint32_t depth;
+  uint32_t *counts;  // depth rows, one after the other; saturate at 2^32-1
+} CountMin;
+
+// width is rounded up to a power of 2, depth is capped at CMS_MAX_DEPTH
+void init_count_min(CountMin *cms, uint32_t width, uint32_t depth);
+// Adds n to the key of this hash and returns its new estimate
+uint64_t count_min_add(CountMin *cms, uint64_t hash, uint32_t n);
+uint64_t count_min_estimate(const CountMin *cms, uint64_t hash);
+void free_count_min(CountMin *cms);
+
+#endif  // LIBS_COUNT_MIN_H_
@@ -0,0 +1,199 @@
+// Copyright 2020 Radu-Stefan Minea 314CA
+
+#include "libs/counters.h"
+
+#include <stdlib.h>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+#if defined(__GNUC__) && defined(__x86_64__)
+#include <immintrin.h>
+#define HAVE_AVX2_DISPATCH
+#endif
+
+#include "libs/utils.h"
+
+void init_counters(Counters *c, size_t size, int width) {
+  if (c == NULL) {
+    return;
+  }
+
+  c->size = size;
+  c->width = width;
+  c->data = calloc(size ? size : 1, width);
+  mem_check(c->data);
+}
+
+// Smallest width (in bytes) able to hold value
+static int width_for(uint64_t value) {
+  if (value <= UINT8_MAX) {
+    return 1;
+  }
+  if (value <= UINT16_MAX) {
+    return 2;
+  }
+  if (value <= UINT32_MAX) {
+    return 4;
+  }
+  return 8;
+}
+
+void counters_set(Counters *c, size_t i, uint64_t value) {
+  if (width_for(value) > c->width) {
+    widen_counters(c, width_for(value));
+  }
+
+  switch (c->width) {
+    case 1:
+      ((uint8_t *)c->data)[i] = value;
+      break;
+    case 2:
+      ((uint16_t *)c->data)[i] = value;
+      break;
+    case 4:
+      ((uint32_t *)c->data)[i] = value;
+      break;
+    default:
+      ((uint64_t *)c->data)[i] = value;
+  }
+}
+
+void counters_add_slow(Counters *c, size_t i, uint64_t n) {
+  uint64_t value = counters_get(c, i);
+
+  // 8-byte counters saturate instead of wrapping around
+  if (value > UINT64_MAX - n) {
+    counters_set(c, i, UINT64_MAX);
+    return;
+  }
+  counters_set(c, i, value + n);
+}
+
+/*
+ * Converting in place, from the last counter to the first one, so that no
+ * counter is overwritten before being read
+ */
+void widen_counters(Counters *c, int width) {
+  if (width <= c->width) {
+    return;
+  }
+
+  size_t size = c->size ? c->size : 1;
+  void *data = realloc(c->data, size * width);
+  mem_check(data);
+
+  Counters old = *c;
+  old.data = data;
+  c->data = data;
+  c->width = width;
+
+  for (size_t i = size; i-- > 0;) {
+    uint64_t value = counters_get(&old, i);
+    switch (width) {
+      case 2:
+        ((uint16_t *)data)[i] = value;
+        break;
+      case 4:
+        ((uint32_t *)data)[i] = value;
+        break;
+      default:
+        ((uint64_t *)data)[i] = value;
+    }
+  }
+}
+
+void free_counters(Counters *c) {
+  if (c == NULL) {
+    return;
+  }
+
+  free(c->data);
+  c->data = NULL;
+}
+
+// First nonzero byte in [p, end), or end
+static const uint8_t *scan_bytes(const uint8_t *p, const uint8_t *end) {
+#ifdef __SSE2__
+  const __m128i zero = _mm_setzero_si128();
+
+  // 64 bytes at a time: one test for the OR of four loads
+  while (end - p >= 64) {
+    __m128i a = _mm_loadu_si128((const __m128i *)p);
+    __m128i b = _mm_loadu_si128((const __m128i *)(p + 16));
+    __m128i c = _mm_loadu_si128((const __m128i *)(p + 32));
+    __m128i d = _mm_loadu_si128((const __m128i *)(p + 48));
+    __m128i any = _mm_or_si128(_mm_or_si128(a, b), _mm_or_si128(c, d));
+    if (_mm_movemask_epi8(_mm_cmpeq_epi8(any, zero)) != 0xFFFF) {
+      break;
+    }
+    p += 64;
+  }
+
+  while (end - p >= 16) {
+    __m128i v = _mm_loadu_si128((const __m128i *)p);
+    unsigned int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(v, zero)) ^ 0xFFFF;
+    if (mask) {
+      return p + __builtin_ctz(mask);
+    }
+    p += 16;
+  }
+#endif
+
+  while (p < end && *p == 0) {
+    p++;
+  }
+  return p;
+}
+
+#ifdef HAVE_AVX2_DISPATCH
+__attribute__((target("avx2")))
+static const uint8_t *scan_bytes_avx2(const uint8_t *p, const uint8_t *end) {
+  const __m256i zero = _mm256_setzero_si256();
+
+  while (end - p >= 64) {
+    __m256i a = _mm256_loadu_si256((const __m256i *)p);
+    __m256i b = _mm256_loadu_si256((const __m256i *)(p + 32));
+    __m256i any = _mm256_or_si256(a, b);
+    if (!_mm256_testz_si256(any, any)) {
+      break;
+    }
+    p += 64;
+  }
+
+  while (end - p >= 32) {
+    __m256i v = _mm256_loadu_si256((const __m256i *)p);
+    unsigned int mask = ~_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, zero));
+    if (mask) {
+      return p + __builtin_ctz(mask);
+    }
+    p += 32;
+  }
+
+  return scan_bytes(p, end);
+}
+#endif
+
+size_t counters_next_nonzero(const Counters *c, size_t from) {
+  if (from >= c->size) {
+    return c->size;
+  }
+
+  // A counter is nonzero iff one of its bytes is => scanning raw bytes
+  const uint8_t *data = c->data;
+  const uint8_t *start = data + from * c->width;
+  const uint8_t *end = data + c->size * c->width;
+  const uint8_t *p;
+
+#ifdef HAVE_AVX2_DISPATCH
+  static int has_avx2 = -1;
+  if (has_avx2 < 0) {
+    has_avx2 = __builtin_cpu_supports("avx2");
+  }
+  p = has_avx2 ? scan_bytes_avx2(start, end) : scan_bytes(start, end);
+#else
+  p = scan_bytes(start, end);
+#endif
+
+  return (p - data) / c->width;
+}
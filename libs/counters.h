@@ -0,0 +1,74 @@
+// Copyright 2020 Radu-Stefan Minea 314CA
+
+#ifndef LIBS_COUNTERS_H_
+#define LIBS_COUNTERS_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Array of counters that all have the same width: 1, 2, 4 or 8 bytes.
+ * It starts at 1 byte per counter and, whenever a counter would overflow,
+ * the whole array is promoted to the next width that fits. Most inputs
+ * never leave 1 byte, and heavy hitters are still counted exactly.
+ */
+typedef struct Counters {
+  void *data;
+  size_t size;
+  int width;
+} Counters;
+
+void init_counters(Counters *c, size_t size, int width);
+void counters_set(Counters *c, size_t i, uint64_t value);
+void counters_add_slow(Counters *c, size_t i, uint64_t n);
+void widen_counters(Counters *c, int width);
+// Index of the first nonzero counter >= from, or size if there's none
+size_t counters_next_nonzero(const Counters *c, size_t from);
+void free_counters(Counters *c);
+
+static inline uint64_t counters_get(const Counters *c, size_t i) {
+  switch (c->width) {
+    case 1:
+      return ((uint8_t *)c->data)[i];
+    case 2:
+      return ((uint16_t *)c->data)[i];
+    case 4:
+      return ((uint32_t *)c->data)[i];
+    default:
+      return ((uint64_t *)c->data)[i];
+  }
+}
+
+static inline void counters_add(Counters *c, size_t i, uint64_t n) {
+  switch (c->width) {
+    case 1: {
+      uint8_t *data = c->data;
+      if (n <= (uint64_t)(UINT8_MAX - data[i])) {
+        data[i] += n;
+        return;
+      }
+      break;
+    }
+    case 2: {
+      uint16_t *data = c->data;
+      if (n <= (uint64_t)(UINT16_MAX - data[i])) {
+        data[i] += n;
+        return;
+      }
+      break;
+    }
+    case 4: {
+      uint32_t *data = c->data;
+      if (n <= (uint64_t)(UINT32_MAX - data[i])) {
+        data[i] += n;
+        return;
+      }
+      break;
+    }
+  }
+
+  // Overflow (or already 8 bytes wide)
+  counters_add_slow(c, i, n);
+}
+
+#endif  // LIBS_COUNTERS_H_
@@ -0,0 +1,306 @@
+// Copyright 2020 Radu-Stefan Minea 314CA
+
+#include "libs/freq_map.h"
+
+#include <stdlib.h>
+
+#include "libs/utils.h"
+
+// Dense counters cost at least 1 byte per value of the range, a bitmap 1 bit
+// and the map 9-16 bytes per slot (at most 3/4 of them used)
+#define DENSE_FACTOR 16
+#define BITMAP_FACTOR 128
+#define MAX_SPAN ((uint64_t)1 << 32)
+// Ranges grow by at least 1/SPARE_DIVISOR, so a stream slowly walking out
+// of its range only causes a logarithmic number of moves
+#define SPARE_DIVISOR 4
+#define WORD_BITS 64
+
+typedef struct value_count {
+  int64_t value;
+  uint64_t cnt;
+} value_count;
+
+void init_freq_map(FreqMap *fm) {
+  if (fm == NULL) {
+    return;
+  }
+
+  fm->mode = FREQ_HASH;
+  fm->distinct = 0;
+  fm->min = INT64_MAX;
+  fm->max = INT64_MIN;
+  fm->base = 0;
+  fm->span = 0;
+  fm->counts.data = NULL;
+  fm->bits = NULL;
+  i64_table_init(&fm->map, 0);
+}
+
+static inline int bit_is_set(uint64_t *bits, uint64_t i) {
+  return (bits[i / WORD_BITS] >> (i % WORD_BITS)) & 1;
+}
+
+// Range with the least memory for distinct values spread over span
+static int choose_mode(uint64_t distinct, uint64_t span) {
+  if (span <= MAX_SPAN && span <= DENSE_FACTOR * distinct) {
+    return FREQ_DENSE;
+  }
+  if (span <= MAX_SPAN && span <= BITMAP_FACTOR * distinct) {
+    return FREQ_BITMAP;
+  }
+  return FREQ_HASH;
+}
+
+// Allocates an empty representation of the given mode and range
+static void init_layout(FreqMap *fm, int mode, int64_t base, uint64_t span) {
+  fm->mode = mode;
+  fm->base = base;
+  fm->span = span;
+  fm->counts.data = NULL;
+  fm->bits = NULL;
+
+  if (mode == FREQ_DENSE) {
+    init_counters(&fm->counts, span, 1);
+  }
+  if (mode == FREQ_BITMAP) {
+    fm->bits = calloc((span + WORD_BITS - 1) / WORD_BITS, sizeof(uint64_t));
+    mem_check(fm->bits);
+  }
+  i64_table_init(&fm->map, mode == FREQ_HASH ? 2 * fm->distinct : 0);
+}
+
+// Sets the count of a value that's new to the (freshly built) layout
+static void set_count(FreqMap *fm, int64_t x, uint64_t cnt) {
+  uint64_t i = (uint64_t)x - (uint64_t)fm->base;
+
+  switch (fm->mode) {
+    case FREQ_DENSE:
+      counters_set(&fm->counts, i, cnt);
+      break;
+    case FREQ_BITMAP:
+      fm->bits[i / WORD_BITS] |= (uint64_t)1 << (i % WORD_BITS);
+      if (cnt > 1) {
+        i64_table_add(&fm->map, x, cnt);
+      }
+      break;
+    default:
+      i64_table_add(&fm->map, x, cnt);
+  }
+}
+
+static void copy_value(int64_t value, uint64_t cnt, void *arg) {
+  set_count(arg, value, cnt);
+}
+
+static void update_min_max(int64_t value, uint64_t cnt, void *arg) {
+  FreqMap *fm = arg;
+  (void)cnt;
+
+  if (value < fm->min) {
+    fm->min = value;
+  }
+  if (value > fm->max) {
+    fm->max = value;
+  }
+}
+
+// Visits every value, in no particular order
+static void visit_unsorted(FreqMap *fm, freq_visit visit, void *arg) {
+  switch (fm->mode) {
+    case FREQ_DENSE:
+      for (uint64_t i = 0; i < fm->span; i++) {
+        uint64_t cnt = counters_get(&fm->counts, i);
+        if (!cnt) {
+          // Skipping the whole run of zero counters with a vectorized scan
+          i = counters_next_nonzero(&fm->counts, i);
+          if (i == fm->span) {
+            break;
+          }
+          cnt = counters_get(&fm->counts, i);
+        }
+        visit((int64_t)((uint64_t)fm->base + i), cnt, arg);
+      }
+      break;
+    case FREQ_BITMAP:
+      for (uint64_t w = 0; w < (fm->span + WORD_BITS - 1) / WORD_BITS; w++) {
+        uint64_t word = fm->bits[w];
+        while (word) {
+          uint64_t i = w * WORD_BITS + __builtin_ctzll(word);
+          int64_t value = (int64_t)((uint64_t)fm->base + i);
+          uint64_t cnt = i64_table_get(&fm->map, value);
+          visit(value, cnt ? cnt : 1, arg);
+          word &= word - 1;
+        }
+      }
+      break;
+    default:
+      for (size_t i = 0; i < fm->map.cap; i++) {
+        uint64_t cnt = counters_get(&fm->map.counts, i);
+        if (cnt) {
+          visit(fm->map.keys[i], cnt, arg);
+        }
+      }
+  }
+}
+
+static void free_layout(FreqMap *fm) {
+  free_counters(&fm->counts);
+  free(fm->bits);
+  i64_table_free(&fm->map);
+}
+
+/*
+ * Called when x doesn't fit in the current layout: picks the layout for
+ * the values seen so far plus x and moves every count there
+ */
+static void relayout(FreqMap *fm, int64_t x) {
+  // Dense/bitmap ranges may have unused ends => finding the real ones
+  if (fm->mode != FREQ_HASH) {
+    fm->min = INT64_MAX;
+    fm->max = INT64_MIN;
+    visit_unsorted(fm, update_min_max, fm);
+  }
+  update_min_max(x, 1, fm);
+
+  uint64_t needed = (uint64_t)fm->max - (uint64_t)fm->min + 1;
+  if (needed == 0) {
+    // The whole 64-bit domain
+    needed = UINT64_MAX;
+  }
+  int mode = choose_mode(fm->distinct + 1, needed);
+
+  // (Unsigned math, since the range may touch INT64_MIN or INT64_MAX)
+  uint64_t lo = (uint64_t)fm->min - (uint64_t)INT64_MIN;
+  uint64_t hi = (uint64_t)fm->max - (uint64_t)INT64_MIN;
+
+  // Same kind of range => keeping the old one and adding 1/SPARE_DIVISOR
+  // of it as spare room on x's side
+  if (mode != FREQ_HASH && mode == fm->mode) {
+    uint64_t old_lo = (uint64_t)fm->base - (uint64_t)INT64_MIN;
+    uint64_t old_hi = old_lo + fm->span - 1;
+    uint64_t spare = fm->span / SPARE_DIVISOR;
+
+    lo = old_lo < lo ? old_lo : lo;
+    hi = old_hi > hi ? old_hi : hi;
+    if (spare > MAX_SPAN - (hi - lo + 1)) {
+      spare = MAX_SPAN - (hi - lo + 1);
+    }
+
+    if (x < fm->base) {
+      lo -= spare < lo ? spare : lo;
+    } else {
+      hi += spare < UINT64_MAX - hi ? spare : UINT64_MAX - hi;
+    }
+  }
+
+  int64_t base = (int64_t)(lo + (uint64_t)INT64_MIN);
+  uint64_t span = mode == FREQ_HASH ? 0 : hi - lo + 1;
+
+  FreqMap old = *fm;
+  init_layout(fm, mode, base, span);
+  visit_unsorted(&old, copy_value, fm);
+  free_layout(&old);
+}
+
+void freq_map_add_slow(FreqMap *fm, int64_t x, uint64_t n) {
+  uint64_t i = (uint64_t)x - (uint64_t)fm->base;
+
+  switch (fm->mode) {
+    case FREQ_DENSE:
+      // Fast path only fails when x is out of range
+      relayout(fm, x);
+      break;
+
+    case FREQ_BITMAP:
+      if (i >= fm->span) {
+        relayout(fm, x);
+        break;
+      }
+
+      if (!bit_is_set(fm->bits, i)) {
+        fm->bits[i / WORD_BITS] |= (uint64_t)1 << (i % WORD_BITS);
+        fm->distinct++;
+        if (n > 1) {
+          i64_table_add(&fm->map, x, n);
+        }
+
+        // Values got dense enough for counters
+        if (fm->span <= DENSE_FACTOR * fm->distinct) {
+          relayout(fm, x);
+        }
+        return;
+      }
+
+      // Seen before: map holds the count, unless it was 1
+      i64_table_add(&fm->map, x, i64_table_get(&fm->map, x) ? n : n + 1);
+      return;
+
+    default:
+      if (i64_table_get(&fm->map, x)) {
+        i64_table_add(&fm->map, x, n);
+        return;
+      }
+
+      // New value; maybe the values fit a range better by now
+      update_min_max(x, n, fm);
+      if (i64_table_full(&fm->map)) {
+        uint64_t span = (uint64_t)fm->max - (uint64_t)fm->min + 1;
+        if (span && choose_mode(fm->distinct + 1, span) != FREQ_HASH) {
+          relayout(fm, x);
+          break;
+        }
+      }
+
+      i64_table_add(&fm->map, x, n);
+      fm->distinct++;
+      return;
+  }
+
+  // Layout changed => adding x to the new one
+  freq_map_add(fm, x, n);
+}
+
+static int compare_values(const void *a, const void *b) {
+  int64_t value_a = ((const value_count *)a)->value;
+  int64_t value_b = ((const value_count *)b)->value;
+
+  return (value_a > value_b) - (value_a < value_b);
+}
+
+static void collect_value(int64_t value, uint64_t cnt, void *arg) {
+  value_count **next = arg;
+
+  (*next)->value = value;
+  (*next)->cnt = cnt;
+  (*next)++;
+}
+
+void freq_map_visit(FreqMap *fm, freq_visit visit, void *arg) {
+  // Ranges are already in order
+  if (fm->mode != FREQ_HASH) {
+    visit_unsorted(fm, visit, arg);
+    return;
+  }
+
+  // The map has to be sorted first: O(distinct * log(distinct))
+  value_count *all = malloc((fm->distinct + 1) * sizeof(value_count));
+  mem_check(all);
+  value_count *next = all;
+
+  visit_unsorted(fm, collect_value, &next);
+  qsort(all, fm->distinct, sizeof(value_count), compare_values);
+  for (uint64_t i = 0; i < fm->distinct; i++) {
+    visit(all[i].value, all[i].cnt, arg);
+  }
+
+  free(all);
+}
+
+void free_freq_map(FreqMap *fm) {
+  if (fm == NULL) {
+    return;
+  }
+
+  free_layout(fm);
+}
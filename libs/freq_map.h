@@ -0,0 +1,56 @@
+// Copyright 2020 Radu-Stefan Minea 314CA
+
+#ifndef LIBS_FREQ_MAP_H_
+#define LIBS_FREQ_MAP_H_
+
+#include <stdint.h>
+
+#include "libs/counters.h"
+#include "libs/typed_table.h"
+
+/*
+ * Frequency of 64-bit integers, in whichever of these takes the least
+ * memory for the values seen so far:
+ * FREQ_DENSE: one counter for every value in [base, base + span)
+ * FREQ_BITMAP: one bit for every value in [base, base + span), set once the
+ * value is seen; values seen more than once also get a count in map
+ * FREQ_HASH: every value and its count in map
+ * The choice is made again whenever a value falls outside the range, or the
+ * map has to grow.
+ */
+enum freq_mode { FREQ_HASH, FREQ_DENSE, FREQ_BITMAP };
+
+typedef struct FreqMap {
+  int mode;
+  uint64_t distinct;
+  int64_t min, max;  // Of the values seen so far
+  int64_t base;
+  uint64_t span;
+  Counters counts;  // FREQ_DENSE
+  uint64_t *bits;  // FREQ_BITMAP
+  I64Table map;  // FREQ_HASH and FREQ_BITMAP
+} FreqMap;
+
+typedef void (*freq_visit)(int64_t value, uint64_t cnt, void *arg);
+
+void init_freq_map(FreqMap *fm);
+void freq_map_add_slow(FreqMap *fm, int64_t x, uint64_t n);
+// Calls visit for every value seen, in increasing order
+void freq_map_visit(FreqMap *fm, freq_visit visit, void *arg);
+void free_freq_map(FreqMap *fm);
+
+static inline void freq_map_add(FreqMap *fm, int64_t x, uint64_t n) {
+  uint64_t i = (uint64_t)x - (uint64_t)fm->base;
+
+  if (fm->mode == FREQ_DENSE && i < fm->span) {
+    if (!counters_get(&fm->counts, i)) {
+      fm->distinct++;
+    }
+    counters_add(&fm->counts, i, n);
+    return;
+  }
+
+  freq_map_add_slow(fm, x, n);
+}
+
+#endif  // LIBS_FREQ_MAP_H_
@@ -0,0 +1,104 @@
+// Copyright 2020 Radu-Stefan Minea 314CA
+
+#include "libs/hash_set.h"
+
+#include <stdlib.h>
+
+#include "libs/hashing.h"
+#include "libs/utils.h"
+
+#define MIN_CAP 16
+
+void init_hash_set(HashSet *set, size_t cap) {
+  if (set == NULL) {
+    return;
+  }
+
+  size_t pow2 = MIN_CAP;
+  while (pow2 < cap) {
+    pow2 <<= 1;
+  }
+
+  set->size = 0;
+  set->cap = pow2;
+  set->has_zero = 0;
+  set->seed = table_seed();
+  set->slots = calloc(pow2, sizeof(uint64_t));
+  mem_check(set->slots);
+}
+
+/*
+ * The hashes are mixed once more, with the seed: hash_u64 (freq) can be
+ * inverted, so their low bits alone could be made to collide
+ */
+static size_t find_slot(const HashSet *set, uint64_t hash) {
+  size_t mask = set->cap - 1;
+  size_t pos = hash_u64(hash ^ set->seed) & mask;
+
+  while (set->slots[pos] && set->slots[pos] != hash) {
+    pos = (pos + 1) & mask;
+  }
+  return pos;
+}
+
+static void resize_hash_set(HashSet *set) {
+  HashSet old = *set;
+
+  init_hash_set(set, 2 * old.cap);
+  set->has_zero = old.has_zero;
+
+  for (size_t i = 0; i < old.cap; i++) {
+    if (old.slots[i]) {
+      set->slots[find_slot(set, old.slots[i])] = old.slots[i];
+      set->size++;
+    }
+  }
+
+  free(old.slots);
+}
+
+int hash_set_add(HashSet *set, uint64_t hash) {
+  if (hash == 0) {
+    int added = !set->has_zero;
+    set->has_zero = 1;
+    return added;
+  }
+
+  size_t pos = find_slot(set, hash);
+  if (set->slots[pos]) {
+    return 0;
+  }
+
+  if (4 * (set->size + 1) > 3 * set->cap) {
+    resize_hash_set(set);
+    pos = find_slot(set, hash);
+  }
+  set->slots[pos] = hash;
+  set->size++;
+  return 1;
+}
+
+void hash_set_union(HashSet *set, const HashSet *other) {
+  if (other->has_zero) {
+    set->has_zero = 1;
+  }
+
+  for (size_t i = 0; i < other->cap; i++) {
+    if (other->slots[i]) {
+      hash_set_add(set, other->slots[i]);
+    }
+  }
+}
+
+size_t hash_set_count(const HashSet *set) {
+  return set->size + set->has_zero;
+}
+
+void free_hash_set(HashSet *set) {
+  if (set == NULL) {
+    return;
+  }
+
+  free(set->slots);
+  set->slots = NULL;
+}
@@ -0,0 +1,33 @@
+// Copyright 2020 Radu-Stefan Minea 314CA
+
+#ifndef LIBS_HASH_SET_H_
+#define LIBS_HASH_SET_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Set of 64-bit hashes: one flat array, linear probing, no keys and no
+ * counts, so a distinct value costs 8-16 bytes whatever its length.
+ * The hashes have to use all 64 bits (wyhash, hash_u64), not 32 like djb2;
+ * they are mixed again with table_seed() to pick their slot.
+ * Slot value 0 means empty (the hash 0 itself is kept aside in has_zero).
+ * Capacity is a power of 2 and the set doubles past load 3/4.
+ */
+typedef struct HashSet {
+  uint64_t *slots;
+  size_t size;  // Without the hash 0
+  size_t cap;
+  int has_zero;
+  uint64_t seed;  // table_seed()
+} HashSet;
+
+void init_hash_set(HashSet *set, size_t cap);
+// 1 if the hash wasn't in the set yet
+int hash_set_add(HashSet *set, uint64_t hash);
+// Adds all the hashes of other to set
+void hash_set_union(HashSet *set, const HashSet *other);
+size_t hash_set_count(const HashSet *set);
+void free_hash_set(HashSet *set);
+
+#endif  // LIBS_HASH_SET_H_
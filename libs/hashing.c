@@ -0,0 +1,45 @@
+// Copyright 2020 Radu-Stefan Minea 314CA
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "libs/hashing.h"
+
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+
+static uint64_t seed;
+static pthread_once_t seed_once = PTHREAD_ONCE_INIT;
+
+// Not cryptographic: the clock, the pid and a (randomized) stack address
+static void pick_seed(void) {
+  struct timespec ts;
+  int local;
+
+  clock_gettime(CLOCK_REALTIME, &ts);
+  seed = hash_u64((uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec);
+  seed = hash_u64(seed ^ (uint64_t)getpid());
+  seed = hash_u64(seed ^ (uint64_t)(uintptr_t)&local);
+}
+
+uint64_t table_seed(void) {
+  pthread_once(&seed_once, pick_seed);
+  return seed;
+}
+
+uint64_t hash_bytes(const void *key, size_t len) {
+  return wyhash(key, len);
+}
+
+uint64_t hash_bytes_djb2(const void *key, size_t len) {
+  /*
+   * Credits: http://www.cse.yorku.ca/~oz/hash.html
+   */
+  const unsigned char *puchar_key = key;
+  unsigned int hash = 5381;
+
+  for (size_t i = 0; i < len; i++)
+    hash = ((hash << 5u) + hash) + puchar_key[i]; /* hash * 33 + c */
+
+  return hash;
+}
@@ -0,0 +1,133 @@
+// Copyright 2020 Radu-Stefan Minea 314CA
+
+#ifndef LIBS_HASHING_H_
+#define LIBS_HASHING_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+/*
+ * Hash functions for keys of a known length: none of them looks for a
+ * '\0', so they also work on keys that aren't NUL-terminated.
+ */
+typedef uint64_t (*hash_fn)(const void *key, size_t len);
+
+// wyhash: reads 8 bytes at a time, good avalanche on short keys
+uint64_t hash_bytes(const void *key, size_t len);
+// djb2, byte by byte; kept to compare against
+uint64_t hash_bytes_djb2(const void *key, size_t len);
+
+/*
+ * Credits: wyhash (final version 4) by Wang Yi,
+ * https://github.com/wangyi-fudan/wyhash
+ */
+static const uint64_t wy_secret[4] = {
+    0x2d358dccaa6c78a5ull, 0x8bb84b93962eacc9ull,
+    0x4b33a62ed433d4a3ull, 0x4d5a2da51de1aa47ull};
+
+// 64 x 64 -> 128 bit multiplication, a = low half, b = high half
+static inline void wy_mum(uint64_t *a, uint64_t *b) {
+  __uint128_t r = (__uint128_t)*a * *b;
+  *a = (uint64_t)r;
+  *b = (uint64_t)(r >> 64);
+}
+
+static inline uint64_t wy_mix(uint64_t a, uint64_t b) {
+  wy_mum(&a, &b);
+  return a ^ b;
+}
+
+static inline uint64_t wy_r8(const uint8_t *p) {
+  uint64_t v;
+  memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+static inline uint64_t wy_r4(const uint8_t *p) {
+  uint32_t v;
+  memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+// 1 to 3 bytes, read without branching on the exact length
+static inline uint64_t wy_r3(const uint8_t *p, size_t len) {
+  return ((uint64_t)p[0] << 16) | ((uint64_t)p[len >> 1] << 8) | p[len - 1];
+}
+
+/*
+ * The body of hash_bytes, inline: hot loops that know their hash function
+ * call this directly, so it can be inlined instead of called through a
+ * hash_fn pointer
+ */
+static inline uint64_t wyhash(const void *key, size_t len) {
+  const uint8_t *p = key;
+  uint64_t seed = wy_mix(wy_secret[0], wy_secret[1]);
+  uint64_t a, b;
+
+  if (len <= 16) {
+    if (len >= 4) {
+      size_t mid = (len >> 3) << 2;
+      a = (wy_r4(p) << 32) | wy_r4(p + mid);
+      b = (wy_r4(p + len - 4) << 32) | wy_r4(p + len - 4 - mid);
+    } else if (len > 0) {
+      a = wy_r3(p, len);
+      b = 0;
+    } else {
+      a = b = 0;
+    }
+  } else {
+    size_t i = len;
+
+    // Three independent lanes for long keys
+    if (i > 48) {
+      uint64_t see1 = seed, see2 = seed;
+      do {
+        seed = wy_mix(wy_r8(p) ^ wy_secret[1], wy_r8(p + 8) ^ seed);
+        see1 = wy_mix(wy_r8(p + 16) ^ wy_secret[2], wy_r8(p + 24) ^ see1);
+        see2 = wy_mix(wy_r8(p + 32) ^ wy_secret[3], wy_r8(p + 40) ^ see2);
+        p += 48;
+        i -= 48;
+      } while (i > 48);
+      seed ^= see1 ^ see2;
+    }
+
+    while (i > 16) {
+      seed = wy_mix(wy_r8(p) ^ wy_secret[1], wy_r8(p + 8) ^ seed);
+      p += 16;
+      i -= 16;
+    }
+
+    // Last 16 bytes (they may overlap with the ones already mixed)
+    a = wy_r8(p + i - 16);
+    b = wy_r8(p + i - 8);
+  }
+
+  a ^= wy_secret[1];
+  b ^= seed;
+  wy_mum(&a, &b);
+  return wy_mix(a ^ wy_secret[0] ^ len, b ^ wy_secret[1]);
+}
+
+/*
+ * For 64-bit integers: every input bit affects every output bit.
+ * Credits: MurmurHash3's fmix64 finalizer, Austin Appleby
+ */
+static inline uint64_t hash_u64(uint64_t x) {
+  x ^= x >> 33;
+  x *= 0xff51afd7ed558ccdull;
+  x ^= x >> 33;
+  x *= 0xc4ceb9fe1a85ec53ull;
+  x ^= x >> 33;
+  return x;
+}
+
+/*
+ * Random, picked once per process. The in-memory tables (I64Table,
+ * HashSet) hash key ^ seed, since hash_u64 alone can be inverted: inputs
+ * made to collide in it (bench/gen_data --dist adversarial) would turn
+ * their probing quadratic.
+ */
+uint64_t table_seed(void);
+
+#endif  // LIBS_HASHING_H_
@@ -0,0 +1,206 @@
+// Copyright 2020 Radu-Stefan Minea 314CA
+
+#include "libs/hll_batch.h"
+
+#include <pthread.h>
+
+#include "libs/hashing.h"
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#include <immintrin.h>
+#define HAVE_SIMD_DISPATCH
+#endif
+
+#define FMIX_C1 0xff51afd7ed558ccdull
+#define FMIX_C2 0xc4ceb9fe1a85ec53ull
+
+/*
+ * A kernel turns count values (32 or 64 bits wide, as given by wide) into
+ * register indexes and ranks
+ */
+typedef void (*batch_kernel)(const void *values, int wide, size_t count,
+                             int precision, uint32_t *index, uint8_t *rank);
+
+static inline uint64_t load_value(const void *values, int wide, size_t i) {
+  if (wide) {
+    return ((const int64_t *)values)[i];
+  }
+  return (uint64_t)(int64_t)((const int32_t *)values)[i];
+}
+
+static void kernel_scalar(const void *values, int wide, size_t count,
+                          int precision, uint32_t *index, uint8_t *rank) {
+  for (size_t i = 0; i < count; i++) {
+    uint64_t hash = hash_u64(load_value(values, wide, i));
+    uint64_t rest = (hash << precision) | ((uint64_t)1 << (precision - 1));
+
+    index[i] = hash >> (64 - precision);
+    rank[i] = __builtin_clzll(rest) + 1;
+  }
+}
+
+#ifdef HAVE_SIMD_DISPATCH
+/*
+ * AVX2 has no 64-bit multiply => a * b (mod 2^64) from 32-bit halves:
+ * lo(a) * lo(b) + ((hi(a) * lo(b) + lo(a) * hi(b)) << 32)
+ */
+__attribute__((target("avx2")))
+static inline __m256i mul64_avx2(__m256i a, __m256i b) {
+  __m256i lo = _mm256_mul_epu32(a, b);
+  __m256i cross = _mm256_add_epi64(
+      _mm256_mul_epu32(_mm256_srli_epi64(a, 32), b),
+      _mm256_mul_epu32(a, _mm256_srli_epi64(b, 32)));
+  return _mm256_add_epi64(lo, _mm256_slli_epi64(cross, 32));
+}
+
+__attribute__((target("avx2")))
+static inline __m256i fmix_avx2(__m256i x) {
+  x = _mm256_xor_si256(x, _mm256_srli_epi64(x, 33));
+  x = mul64_avx2(x, _mm256_set1_epi64x(FMIX_C1));
+  x = _mm256_xor_si256(x, _mm256_srli_epi64(x, 33));
+  x = mul64_avx2(x, _mm256_set1_epi64x(FMIX_C2));
+  return _mm256_xor_si256(x, _mm256_srli_epi64(x, 33));
+}
+
+// 4 hashes per step; AVX2 has no vector lzcnt => ranks lane by lane
+__attribute__((target("avx2,lzcnt")))
+static void kernel_avx2(const void *values, int wide, size_t count,
+                        int precision, uint32_t *index, uint8_t *rank) {
+  const __m128i index_shift = _mm_cvtsi32_si128(64 - precision);
+  const __m128i rest_shift = _mm_cvtsi32_si128(precision);
+  const __m256i stop = _mm256_set1_epi64x((int64_t)1 << (precision - 1));
+  size_t i = 0;
+
+  for (; i + 4 <= count; i += 4) {
+    __m256i x;
+    if (wide) {
+      x = _mm256_loadu_si256((const __m256i *)((const int64_t *)values + i));
+    } else {
+      x = _mm256_cvtepi32_epi64(
+          _mm_loadu_si128((const __m128i *)((const int32_t *)values + i)));
+    }
+
+    __m256i hash = fmix_avx2(x);
+    __m256i idx = _mm256_srl_epi64(hash, index_shift);
+    __m256i rest = _mm256_or_si256(_mm256_sll_epi64(hash, rest_shift), stop);
+
+    uint64_t idx_lanes[4], rest_lanes[4];
+    _mm256_storeu_si256((__m256i *)idx_lanes, idx);
+    _mm256_storeu_si256((__m256i *)rest_lanes, rest);
+    for (int j = 0; j < 4; j++) {
+      index[i + j] = idx_lanes[j];
+      rank[i + j] = _lzcnt_u64(rest_lanes[j]) + 1;
+    }
+  }
+
+  kernel_scalar(wide ? (const void *)((const int64_t *)values + i)
+                     : (const void *)((const int32_t *)values + i),
+                wide, count - i, precision, index + i, rank + i);
+}
+
+// 8 hashes per step, with native 64-bit multiplies and a vector lzcnt
+__attribute__((target("avx512f,avx512dq,avx512cd")))
+static void kernel_avx512(const void *values, int wide, size_t count,
+                          int precision, uint32_t *index, uint8_t *rank) {
+  const __m512i c1 = _mm512_set1_epi64(FMIX_C1);
+  const __m512i c2 = _mm512_set1_epi64(FMIX_C2);
+  const __m512i stop = _mm512_set1_epi64((int64_t)1 << (precision - 1));
+  const __m512i one = _mm512_set1_epi64(1);
+  const __m128i index_shift = _mm_cvtsi32_si128(64 - precision);
+  const __m128i rest_shift = _mm_cvtsi32_si128(precision);
+  size_t i = 0;
+
+  for (; i + 8 <= count; i += 8) {
+    __m512i x;
+    if (wide) {
+      x = _mm512_loadu_si512((const int64_t *)values + i);
+    } else {
+      x = _mm512_cvtepi32_epi64(
+          _mm256_loadu_si256((const __m256i *)((const int32_t *)values + i)));
+    }
+
+    x = _mm512_xor_si512(x, _mm512_srli_epi64(x, 33));
+    x = _mm512_mullo_epi64(x, c1);
+    x = _mm512_xor_si512(x, _mm512_srli_epi64(x, 33));
+    x = _mm512_mullo_epi64(x, c2);
+    x = _mm512_xor_si512(x, _mm512_srli_epi64(x, 33));
+
+    __m512i idx = _mm512_srl_epi64(x, index_shift);
+    __m512i rest = _mm512_or_si512(_mm512_sll_epi64(x, rest_shift), stop);
+    __m512i rnk = _mm512_add_epi64(_mm512_lzcnt_epi64(rest), one);
+
+    // Narrowing the lanes: indexes to 32 bits, ranks to 8 bits
+    _mm256_storeu_si256((__m256i *)(index + i), _mm512_cvtepi64_epi32(idx));
+    _mm_storel_epi64((__m128i *)(rank + i), _mm512_cvtepi64_epi8(rnk));
+  }
+
+  kernel_scalar(wide ? (const void *)((const int64_t *)values + i)
+                     : (const void *)((const int32_t *)values + i),
+                wide, count - i, precision, index + i, rank + i);
+}
+#endif
+
+static batch_kernel kernel = NULL;
+// The first batches may come from several threads at once (hll --threads)
+static pthread_once_t kernel_once = PTHREAD_ONCE_INIT;
+
+int hll_batch_select(int isa) {
+#ifdef HAVE_SIMD_DISPATCH
+  if ((isa == HLL_ISA_AUTO || isa == HLL_ISA_AVX512) &&
+      __builtin_cpu_supports("avx512f") &&
+      __builtin_cpu_supports("avx512dq") &&
+      __builtin_cpu_supports("avx512cd")) {
+    kernel = kernel_avx512;
+    return HLL_ISA_AVX512;
+  }
+  if ((isa == HLL_ISA_AUTO || isa >= HLL_ISA_AVX2) &&
+      __builtin_cpu_supports("avx2") && __builtin_cpu_supports("abm")) {
+    kernel = kernel_avx2;
+    return HLL_ISA_AVX2;
+  }
+#endif
+  (void)isa;
+  kernel = kernel_scalar;
+  return HLL_ISA_SCALAR;
+}
+
+// Unless hll_batch_select was called before
+static void select_default(void) {
+  if (kernel == NULL) {
+    hll_batch_select(HLL_ISA_AUTO);
+  }
+}
+
+static void add_batch(Hll *h, const void *values, int wide, size_t n) {
+  pthread_once(&kernel_once, select_default);
+
+  uint32_t index[HLL_BATCH_SIZE];
+  uint8_t rank[HLL_BATCH_SIZE];
+
+  for (size_t done = 0; done < n; done += HLL_BATCH_SIZE) {
+    size_t count = n - done < HLL_BATCH_SIZE ? n - done : HLL_BATCH_SIZE;
+    const void *chunk = wide ? (const void *)((const int64_t *)values + done)
+                             : (const void *)((const int32_t *)values + done);
+
+    kernel(chunk, wide, count, h->precision, index, rank);
+
+    // Lanes may hit the same register => max-updates one at a time
+    for (size_t i = 0; i < count; i++) {
+      hll_update(h, index[i], rank[i]);
+    }
+  }
+}
+
+void hll_hash_batch(const int64_t *values, size_t n, int precision,
+                    uint32_t *index, uint8_t *rank) {
+  pthread_once(&kernel_once, select_default);
+  kernel(values, 1, n, precision, index, rank);
+}
+
+void hll_add_i64_batch(Hll *h, const int64_t *values, size_t n) {
+  add_batch(h, values, 1, n);
+}
+
+void hll_add_i32_batch(Hll *h, const int32_t *values, size_t n) {
+  add_batch(h, values, 0, n);
+}
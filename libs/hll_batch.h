@@ -0,0 +1,37 @@
+// Copyright 2020 Radu-Stefan Minea 314CA
+
+#ifndef LIBS_HLL_BATCH_H_
+#define LIBS_HLL_BATCH_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "libs/hll_sketch.h"
+
+// Values handed to the kernels at once (callers may use any batch size)
+#define HLL_BATCH_SIZE 256
+
+/*
+ * Adds arrays of values to a sketch, with the same hash as
+ * hll_add_hash(h, hash_u64(value)) (32-bit values are sign-extended first),
+ * so the registers end up identical to adding them one by one.
+ * The hash, register index and rank of 8 values at once are computed with
+ * AVX-512 (vector lzcnt), 4 at once with AVX2, or one by one, depending on
+ * what the CPU supports; registers are then updated in order.
+ */
+void hll_add_i64_batch(Hll *h, const int64_t *values, size_t n);
+void hll_add_i32_batch(Hll *h, const int32_t *values, size_t n);
+// Only the register index and rank of every value, for other register stores
+void hll_hash_batch(const int64_t *values, size_t n, int precision,
+                    uint32_t *index, uint8_t *rank);
+
+enum hll_isa { HLL_ISA_AUTO, HLL_ISA_SCALAR, HLL_ISA_AVX2, HLL_ISA_AVX512 };
+/*
+ * Picks the kernel used from now on: the best one the CPU supports, up to
+ * isa (HLL_ISA_AUTO => the best one). Returns the one picked. Done once,
+ * on the first batch, otherwise; meant for benchmarks and tests, and has
+ * to be called before any threads start adding batches.
+ */
+int hll_batch_select(int isa);
+
+#endif  // LIBS_HLL_BATCH_H_
@@ -0,0 +1,551 @@
+// Copyright 2020 Radu-Stefan Minea 314CA
+
+// Generated by tools/gen_hll_bias.c (make hll_bias)
+
+#include "libs/hll_bias.h"
+
+const double hll_bias_raw[HLL_PRECISIONS][HLL_BIAS_POINTS] = {
+  {  // p = 4
+    11.7225, 12.2232, 13.2716, 13.8187,
+    14.9618, 15.5562, 16.7918, 17.4361,
+    18.7681, 19.456, 20.8754, 21.607,
+    23.1082, 23.8793, 25.4633, 26.2727,
+    27.9306, 28.7754, 30.497, 31.3711,
+    33.1421, 34.0394, 35.8691, 36.7917,
+    38.6547, 39.5962, 41.4909, 42.4459,
+    44.3578, 45.322, 47.2668, 48.2406,
+    50.2038, 51.1838, 53.1529, 54.1379,
+    56.1232, 57.1211, 59.1029, 60.0951,
+    62.0787, 63.0711, 65.0647, 66.0624,
+    68.0681, 69.0651, 71.0645, 72.0597,
+    74.0539, 75.0509, 77.0395, 78.0405,
+    80.0425, 81.0509, 83.0446, 84.0403,
+    86.0289, 87.0263, 89.017, 90.0253,
+    92.0407, 93.0451, 95.0489, 96.0535,
+  },
+  {  // p = 5
+    23.7522, 25.2679, 26.8509, 28.5026,
+    30.2199, 32.0047, 33.8569, 35.7735,
+    37.7613, 39.8104, 41.9224, 44.0896,
+    46.3199, 48.6035, 50.944, 53.3391,
+    55.7862, 58.2799, 60.8231, 63.3973,
+    66.0211, 68.6786, 71.3667, 74.1025,
+    76.8481, 79.6244, 82.4244, 85.2659,
+    88.1099, 90.9654, 93.8386, 96.7344,
+    99.6439, 102.576, 105.493, 108.433,
+    111.386, 114.323, 117.268, 120.221,
+    123.204, 126.174, 129.138, 132.107,
+    135.083, 138.083, 141.091, 144.064,
+    147.058, 150.059, 153.032, 156.021,
+    159.019, 162.018, 165.039, 168.039,
+    171.012, 174.01, 176.993, 179.972,
+    182.952, 185.942, 188.938, 191.94,
+  },
+  {  // p = 6
+    48.2997, 51.3535, 54.5394, 57.8612,
+    61.3131, 64.8977, 68.6126, 72.4572,
+    76.4295, 80.5304, 84.7507, 89.0905,
+    93.5427, 98.1048, 102.761, 107.523,
+    112.393, 117.337, 122.385, 127.516,
+    132.741, 138.02, 143.368, 148.785,
+    154.273, 159.815, 165.367, 170.98,
+    176.604, 182.289, 188.01, 193.767,
+    199.571, 205.399, 211.199, 217.092,
+    222.962, 228.884, 234.785, 240.696,
+    246.639, 252.551, 258.487, 264.451,
+    270.394, 276.342, 282.326, 288.276,
+    294.269, 300.263, 306.258, 312.249,
+    318.265, 324.25, 330.257, 336.279,
+    342.302, 348.309, 354.259, 360.263,
+    366.306, 372.3, 378.265, 384.292,
+  },
+  {  // p = 7
+    97.4274, 103.564, 109.972, 116.622,
+    123.542, 130.712, 138.165, 145.857,
+    153.802, 161.969, 170.394, 179.052,
+    187.922, 197.037, 206.329, 215.785,
+    225.507, 235.405, 245.466, 255.651,
+    266.04, 276.545, 287.205, 297.912,
+    308.852, 319.807, 330.884, 342.06,
+    353.291, 364.626, 376.043, 387.535,
+    399.115, 410.692, 422.385, 434.031,
+    445.727, 457.508, 469.276, 481.117,
+    492.97, 504.841, 516.693, 528.589,
+    540.493, 552.367, 564.311, 576.271,
+    588.161, 600.096, 612.035, 624.068,
+    636.031, 648.118, 660.145, 672.173,
+    684.121, 696.034, 708.042, 720.079,
+    732.101, 744.095, 756.07, 768.09,
+  },
+  {  // p = 8
+    195.644, 207.929, 220.736, 234.068,
+    247.934, 262.308, 277.21, 292.598,
+    308.502, 324.846, 341.681, 358.967,
+    376.7, 394.9, 413.415, 432.355,
+    451.675, 471.36, 491.485, 511.952,
+    532.668, 553.671, 574.993, 596.478,
+    618.185, 640.163, 662.305, 684.785,
+    707.342, 729.925, 752.823, 775.705,
+    798.77, 821.887, 845.222, 868.55,
+    891.99, 915.403, 938.977, 962.499,
+    986.218, 1010.01, 1033.51, 1057.41,
+    1081.26, 1105.22, 1128.96, 1152.83,
+    1176.61, 1200.63, 1224.59, 1248.64,
+    1272.53, 1296.26, 1320.07, 1343.92,
+    1367.93, 1391.65, 1415.57, 1439.44,
+    1463.38, 1487.35, 1511.45, 1535.31,
+  },
+  {  // p = 9
+    392.102, 416.703, 442.318, 469.046,
+    496.769, 525.506, 555.313, 586.138,
+    617.957, 650.728, 684.435, 719.075,
+    754.488, 790.697, 828.018, 865.917,
+    904.675, 944.116, 984.011, 1024.86,
+    1066.16, 1108.13, 1150.52, 1193.33,
+    1236.85, 1280.86, 1325.13, 1369.95,
+    1414.97, 1460.43, 1506.17, 1551.89,
+    1598.1, 1644.37, 1690.68, 1737.13,
+    1783.85, 1830.93, 1878.01, 1925.65,
+    1972.93, 2020.24, 2067.59, 2115.37,
+    2163.12, 2210.59, 2257.84, 2305.65,
+    2353.27, 2401.09, 2448.88, 2496.53,
+    2544.42, 2592.47, 2640.22, 2688.1,
+    2735.9, 2784, 2832.08, 2879.84,
+    2927.6, 2975.53, 3023.86, 3072.04,
+  },
+  {  // p = 10
+    784.964, 834.143, 885.385, 938.759,
+    994.212, 1051.89, 1111.41, 1173,
+    1236.36, 1301.85, 1369.29, 1438.6,
+    1509.66, 1582.49, 1656.93, 1732.68,
+    1810.24, 1889.12, 1969.22, 2050.81,
+    2133.45, 2217.52, 2301.93, 2387.92,
+    2474.52, 2562.48, 2651.31, 2740.56,
+    2830.58, 2921.32, 3012.6, 3104.5,
+    3196.77, 3289.77, 3382.43, 3475.91,
+    3569.42, 3663.07, 3757.2, 3851.15,
+    3945.34, 4039.95, 4134.77, 4230.19,
+    4325.54, 4421.07, 4516.04, 4610.78,
+    4706.37, 4801.41, 4897.12, 4993.03,
+    5089.28, 5185.65, 5281.17, 5376.52,
+    5472.66, 5568.49, 5663.78, 5759.69,
+    5855.62, 5951.94, 6047.84, 6143.31,
+  },
+  {  // p = 11
+    1570.81, 1669.42, 1772.08, 1878.99,
+    1989.87, 2104.79, 2223.79, 2346.85,
+    2473.98, 2604.9, 2739.51, 2878.17,
+    3020.15, 3165.23, 3313.89, 3465.88,
+    3620.32, 3777.93, 3938.72, 4101.23,
+    4266.59, 4433.69, 4604.02, 4775.92,
+    4950.23, 5125.79, 5302.63, 5480.45,
+    5660.85, 5842.03, 6024.85, 6208.42,
+    6391.95, 6576.9, 6763.01, 6949.43,
+    7137.03, 7325.21, 7513.95, 7702.32,
+    7892.52, 8080.76, 8270.44, 8460.01,
+    8649.93, 8841.43, 9031.41, 9223.81,
+    9415.24, 9606.15, 9797.73, 9989.61,
+    10180.6, 10372.6, 10563.1, 10757.3,
+    10949.7, 11141.9, 11334.9, 11526.1,
+    11716.8, 11909.8, 12101.5, 12292.2,
+  },
+  {  // p = 12
+    3142.4, 3339.56, 3545.06, 3758.82,
+    3980.82, 4210.96, 4449.28, 4695.5,
+    4949.34, 5211.74, 5481.17, 5757.55,
+    6040.56, 6330.75, 6627.37, 6931.44,
+    7240.24, 7555.88, 7877.01, 8201.73,
+    8532.92, 8866.34, 9205.36, 9548.09,
+    9895.55, 10244.9, 10598, 10955.4,
+    11314.7, 11677.2, 12041.6, 12410.4,
+    12778.7, 13148.4, 13518.1, 13890.2,
+    14263.9, 14639.9, 15014.8, 15392.6,
+    15773.1, 16150.9, 16531.5, 16912.9,
+    17293.8, 17673.8, 18056.1, 18436,
+    18814.8, 19196.2, 19579.2, 19960.4,
+    20344.4, 20726.4, 21111.8, 21492.5,
+    21874.3, 22256, 22639.5, 23024.6,
+    23409.9, 23791.5, 24174, 24558.7,
+  },
+  {  // p = 13
+    6285.56, 6679.61, 7090.32, 7517.64,
+    7961.7, 8422.5, 8899.8, 9390.98,
+    9898.23, 10422.3, 10961.5, 11515.4,
+    12081.5, 12663.5, 13257.1, 13863.4,
+    14483.1, 15113.2, 15755.2, 16406.5,
+    17069.3, 17739.3, 18417.4, 19105.4,
+    19800.9, 20502.9, 21212.2, 21925.3,
+    22644.5, 23365.8, 24092.6, 24826.1,
+    25562.3, 26303.8, 27045.3, 27794.4,
+    28545.3, 29295.1, 30048.6, 30799.8,
+    31555.1, 32310, 33067, 33835.2,
+    34600.5, 35363.5, 36131.9, 36897.7,
+    37665.3, 38433.7, 39201.3, 39965.1,
+    40731.5, 41500.4, 42271.1, 43045.6,
+    43819.1, 44588.3, 45353.2, 46124.2,
+    46890.1, 47659.8, 48428.3, 49194.8,
+  },
+  {  // p = 14
+    12572.2, 13360, 14181.1, 15035.1,
+    15923.1, 16844.7, 17797.8, 18782,
+    19800.6, 20847.7, 21923.5, 23030.1,
+    24163, 25323.2, 26511.5, 27724.1,
+    28959.2, 30218, 31506, 32805.3,
+    34131.8, 35475, 36830.4, 38207.1,
+    39591.4, 41003.5, 42425.4, 43845.1,
+    45280.1, 46734.3, 48190.2, 49647.9,
+    51122.5, 52602.5, 54082.3, 55586.9,
+    57079.2, 58590.7, 60096.4, 61600.6,
+    63115.1, 64628.9, 66148.7, 67657.4,
+    69181.6, 70702, 72226.4, 73757,
+    75279, 76803.7, 78329.6, 79860,
+    81375.3, 82896, 84427.9, 85956.5,
+    87487, 89011.8, 90557.2, 92083.5,
+    93620.5, 95159, 96705.8, 98231.2,
+  },
+  {  // p = 15
+    25144.7, 26720, 28361.8, 30072.8,
+    31847.2, 33689.4, 35593.8, 37568.3,
+    39599.5, 41691.1, 43848.5, 46060.6,
+    48331, 50655.2, 53039.1, 55468.4,
+    57938.4, 60458.8, 63028, 65635.3,
+    68281.9, 70963.5, 73679.5, 76408.3,
+    79183.9, 81990.3, 84817.5, 87668.5,
+    90549.5, 93433.7, 96349.4, 99278.8,
+    102205, 105170, 108141, 111107,
+    114120, 117120, 120144, 123154,
+    126161, 129169, 132208, 135263,
+    138294, 141366, 144413, 147492,
+    150540, 153612, 156678, 159731,
+    162799, 165851, 168924, 171984,
+    175036, 178087, 181142, 184203,
+    187274, 190334, 193387, 196463,
+  },
+  {  // p = 16
+    50294.1, 53448.8, 56729.3, 60151.4,
+    63703.3, 67393.7, 71209.5, 75157.9,
+    79230.4, 83418.8, 87736.6, 92177.5,
+    96709.4, 101350, 106087, 110933,
+    115888, 120937, 126069, 131277,
+    136582, 141945, 147379, 152872,
+    158424, 164026, 169711, 175425,
+    181156, 186940, 192788, 198657,
+    204558, 210464, 216427, 222389,
+    228424, 234446, 240481, 246551,
+    252578, 258633, 264729, 270779,
+    276899, 282992, 289093, 295204,
+    301316, 307441, 313574, 319706,
+    325835, 331905, 338043, 344193,
+    350319, 356450, 362585, 368681,
+    374787, 381001, 387159, 393288,
+  },
+  {  // p = 17
+    100582, 106877, 113452, 120294,
+    127405, 134775, 142407, 150275,
+    158415, 166798, 175404, 184241,
+    193312, 202584, 212078, 221776,
+    231675, 241743, 252014, 262421,
+    272998, 283705, 294595, 305580,
+    316744, 328017, 339338, 350739,
+    362253, 373836, 385512, 397192,
+    409053, 420897, 432704, 444604,
+    456574, 468623, 480704, 492742,
+    504815, 517031, 529272, 541482,
+    553649, 565809, 577965, 590220,
+    602465, 614686, 626932, 639073,
+    651367, 663740, 676144, 688420,
+    700673, 712833, 725131, 737406,
+    749661, 761921, 774185, 786435,
+  },
+  {  // p = 18
+    201163, 213787, 226938, 240611,
+    254816, 269543, 284802, 300578,
+    316865, 333614, 350869, 368576,
+    386712, 405296, 424321, 443718,
+    463487, 483665, 504204, 525039,
+    546170, 567566, 589279, 611272,
+    633451, 655923, 678642, 701436,
+    724375, 747492, 770874, 794359,
+    817909, 841638, 865433, 889308,
+    913434, 937425, 961440, 985552,
+    1.0097e+06, 1.03379e+06, 1.05803e+06, 1.08241e+06,
+    1.10694e+06, 1.13136e+06, 1.15567e+06, 1.18015e+06,
+    1.20453e+06, 1.22907e+06, 1.25348e+06, 1.27791e+06,
+    1.30239e+06, 1.32692e+06, 1.35153e+06, 1.37603e+06,
+    1.40074e+06, 1.42517e+06, 1.44983e+06, 1.47432e+06,
+    1.49877e+06, 1.5233e+06, 1.5479e+06, 1.57252e+06,
+  },
+};
+
+const double hll_bias_value[HLL_PRECISIONS][HLL_BIAS_POINTS] = {
+  {  // p = 4
+    9.72248, 9.2232, 8.27163, 7.81867,
+    6.96183, 6.55623, 5.79184, 5.43609,
+    4.76812, 4.45604, 3.87542, 3.60702,
+    3.10817, 2.8793, 2.46332, 2.27268,
+    1.93061, 1.77537, 1.49696, 1.37115,
+    1.14215, 1.03943, 0.869051, 0.791736,
+    0.654654, 0.596178, 0.490891, 0.445916,
+    0.357826, 0.321995, 0.266792, 0.240581,
+    0.203815, 0.183753, 0.152898, 0.137921,
+    0.123192, 0.121052, 0.102914, 0.0951307,
+    0.0786756, 0.0710633, 0.0647022, 0.0623632,
+    0.0680606, 0.065094, 0.0644739, 0.0596977,
+    0.0539251, 0.0509204, 0.039523, 0.0405462,
+    0.0425296, 0.0509193, 0.0446339, 0.0403081,
+    0.0289217, 0.0262556, 0.0170084, 0.0252629,
+    0.0406999, 0.0450826, 0.0489436, 0.0535363,
+  },
+  {  // p = 5
+    20.7522, 19.2679, 17.8509, 16.5026,
+    15.2199, 14.0047, 12.8569, 11.7735,
+    10.7613, 9.81039, 8.92238, 8.08961,
+    7.31991, 6.60346, 5.94396, 5.33914,
+    4.78619, 4.27993, 3.82311, 3.39726,
+    3.02107, 2.67864, 2.3667, 2.10245,
+    1.84812, 1.62441, 1.42437, 1.26593,
+    1.1099, 0.965433, 0.838615, 0.73439,
+    0.64391, 0.576284, 0.493475, 0.43256,
+    0.385591, 0.323198, 0.268202, 0.220942,
+    0.204235, 0.173587, 0.13842, 0.107349,
+    0.0831682, 0.0834611, 0.0911127, 0.0638774,
+    0.0579566, 0.0592069, 0.032242, 0.0205521,
+    0.0191909, 0.0184025, 0.0390601, 0.0391942,
+    0.012231, 0.0101203, -0.00676279, -0.0276463,
+    -0.0484379, -0.057758, -0.0616884, -0.0598365,
+  },
+  {  // p = 6
+    42.2997, 39.3535, 36.5394, 33.8612,
+    31.3131, 28.8977, 26.6126, 24.4572,
+    22.4295, 20.5304, 18.7507, 17.0905,
+    15.5427, 14.1048, 12.7613, 11.5233,
+    10.3929, 9.33719, 8.38514, 7.51599,
+    6.7414, 6.02039, 5.36824, 4.78544,
+    4.27253, 3.81468, 3.36723, 2.9802,
+    2.60374, 2.28888, 2.01025, 1.76742,
+    1.571, 1.39892, 1.19949, 1.09184,
+    0.962475, 0.883965, 0.785377, 0.696211,
+    0.639241, 0.550955, 0.486863, 0.450666,
+    0.394313, 0.341621, 0.326111, 0.27598,
+    0.268919, 0.263449, 0.258359, 0.248704,
+    0.264885, 0.250419, 0.256891, 0.278795,
+    0.30223, 0.309437, 0.259066, 0.263399,
+    0.305755, 0.299871, 0.265245, 0.291957,
+  },
+  {  // p = 7
+    85.4274, 79.5641, 73.9717, 68.6219,
+    63.5417, 58.7117, 54.1652, 49.8566,
+    45.8017, 41.9686, 38.3945, 35.0522,
+    31.9221, 29.0374, 26.3288, 23.7846,
+    21.5072, 19.4052, 17.4665, 15.651,
+    14.0405, 12.5455, 11.2048, 9.91232,
+    8.85222, 7.80681, 6.88429, 6.05953,
+    5.29118, 4.62627, 4.04259, 3.53486,
+    3.11467, 2.69212, 2.38476, 2.03094,
+    1.72687, 1.5081, 1.27644, 1.11681,
+    0.969767, 0.841434, 0.692566, 0.589319,
+    0.492724, 0.36729, 0.31094, 0.271325,
+    0.161074, 0.0960949, 0.0352335, 0.0675994,
+    0.0312605, 0.118207, 0.144895, 0.172875,
+    0.121114, 0.033827, 0.0423968, 0.0794134,
+    0.101108, 0.0945984, 0.0702663, 0.0898506,
+  },
+  {  // p = 8
+    171.644, 159.929, 148.736, 138.068,
+    127.934, 118.308, 109.21, 100.598,
+    92.502, 84.8461, 77.6806, 70.9669,
+    64.7, 58.8995, 53.4145, 48.3548,
+    43.6749, 39.3599, 35.4848, 31.9518,
+    28.6682, 25.6713, 22.9926, 20.4779,
+    18.1848, 16.163, 14.3049, 12.7852,
+    11.3423, 9.92531, 8.82275, 7.7046,
+    6.77014, 5.88661, 5.222, 4.55041,
+    3.99012, 3.40269, 2.9769, 2.49943,
+    2.21828, 2.00641, 1.50516, 1.41142,
+    1.25802, 1.21526, 0.958629, 0.825981,
+    0.611988, 0.626765, 0.589851, 0.640407,
+    0.525223, 0.261571, 0.0732615, -0.075885,
+    -0.0685123, -0.354964, -0.429522, -0.55734,
+    -0.623993, -0.654006, -0.547792, -0.68832,
+  },
+  {  // p = 9
+    344.102, 320.703, 298.318, 277.046,
+    256.769, 237.506, 219.313, 202.138,
+    185.957, 170.728, 156.435, 143.075,
+    130.488, 118.697, 108.018, 97.9173,
+    88.6746, 80.116, 72.0107, 64.8581,
+    58.1632, 52.1255, 46.5182, 41.3311,
+    36.849, 32.8564, 29.134, 25.9513,
+    22.9668, 20.4345, 18.168, 15.8898,
+    14.1042, 12.3666, 10.6775, 9.12597,
+    7.85494, 6.9298, 6.01251, 5.64998,
+    4.92979, 4.23952, 3.5903, 3.37051,
+    3.11617, 2.59119, 1.83817, 1.65435,
+    1.2702, 1.09265, 0.883122, 0.526353,
+    0.41523, 0.472724, 0.223598, 0.0955116,
+    -0.102798, -0.000530079, 0.0845141, -0.156354,
+    -0.404668, -0.470785, -0.141591, 0.0418327,
+  },
+  {  // p = 10
+    688.964, 642.143, 597.385, 554.759,
+    514.212, 475.887, 439.412, 405,
+    372.364, 341.85, 313.288, 286.595,
+    261.656, 238.49, 216.925, 196.683,
+    178.24, 161.119, 145.216, 130.806,
+    117.451, 105.519, 93.9296, 83.9204,
+    74.5196, 66.4753, 59.3062, 52.5599,
+    46.5794, 41.3175, 36.5988, 32.503,
+    28.7695, 25.7667, 22.4337, 19.9109,
+    17.4218, 15.0715, 13.197, 11.1501,
+    9.33768, 7.94655, 6.7683, 6.18967,
+    5.53878, 5.07356, 4.03583, 2.78431,
+    2.37338, 1.40865, 1.11552, 1.03483,
+    1.28148, 1.64745, 1.17082, 0.523473,
+    0.656066, 0.494873, -0.217047, -0.313522,
+    -0.384266, -0.0621148, -0.155296, -0.689137,
+  },
+  {  // p = 11
+    1378.81, 1285.42, 1196.08, 1110.99,
+    1029.87, 952.789, 879.79, 810.847,
+    745.981, 684.898, 627.512, 574.165,
+    524.153, 477.229, 433.889, 393.882,
+    356.322, 321.931, 290.718, 261.226,
+    234.59, 209.69, 188.015, 167.92,
+    150.227, 133.793, 118.634, 104.447,
+    92.8526, 82.0276, 72.8476, 64.4228,
+    55.9482, 48.9047, 43.0051, 37.4276,
+    33.0317, 29.2145, 25.9451, 22.3227,
+    20.5249, 16.764, 14.4375, 12.0144,
+    9.92699, 9.42725, 7.40512, 7.81313,
+    7.23803, 6.15236, 5.73163, 5.60608,
+    4.60374, 4.62398, 3.13539, 5.34844,
+    5.73497, 5.91137, 6.87882, 6.1206,
+    4.79454, 5.79726, 5.4805, 4.19925,
+  },
+  {  // p = 12
+    2758.4, 2571.56, 2393.06, 2222.82,
+    2060.82, 1906.96, 1761.28, 1623.5,
+    1493.34, 1371.74, 1257.17, 1149.55,
+    1048.56, 954.755, 867.369, 787.439,
+    712.241, 643.88, 581.008, 521.732,
+    468.917, 418.336, 373.358, 332.09,
+    295.549, 260.859, 229.991, 203.359,
+    178.666, 157.165, 137.558, 122.351,
+    106.748, 92.4102, 78.07, 66.1785,
+    55.9164, 47.8578, 38.8188, 32.5818,
+    29.0905, 22.869, 19.5294, 16.933,
+    13.785, 9.77996, 8.11997, 4.02183,
+    -1.1522, -3.76544, -4.79788, -7.59907,
+    -7.55497, -9.62534, -8.15036, -11.5232,
+    -13.7267, -16.0183, -16.5476, -15.4488,
+    -14.1021, -16.5347, -18.0454, -17.3154,
+  },
+  {  // p = 13
+    5517.56, 5143.61, 4786.32, 4445.64,
+    4121.7, 3814.5, 3523.8, 3246.98,
+    2986.23, 2742.35, 2513.49, 2299.4,
+    2097.51, 1911.45, 1737.11, 1575.36,
+    1427.12, 1289.16, 1163.15, 1046.46,
+    941.291, 843.325, 753.43, 673.417,
+    600.92, 534.875, 476.211, 421.257,
+    372.522, 325.82, 284.604, 250.075,
+    218.345, 191.813, 165.25, 146.424,
+    129.28, 111.113, 96.621, 79.7538,
+    67.1094, 53.9576, 43.0148, 43.171,
+    40.5243, 35.4707, 35.9234, 33.6727,
+    33.3319, 33.7499, 33.2733, 29.0636,
+    27.4862, 28.37, 31.147, 37.5642,
+    43.0804, 44.3099, 41.2485, 44.2434,
+    42.0633, 43.7967, 44.3368, 42.8165,
+  },
+  {  // p = 14
+    11036.2, 10288, 9573.09, 8891.09,
+    8243.09, 7628.69, 7045.78, 6494,
+    5976.56, 5487.68, 5027.45, 4598.06,
+    4195.05, 3819.17, 3471.49, 3148.09,
+    2847.17, 2569.99, 2321.96, 2085.28,
+    1875.85, 1683.01, 1502.44, 1343.07,
+    1191.41, 1067.47, 953.415, 837.111,
+    736.096, 654.273, 574.198, 495.86,
+    434.459, 378.464, 322.308, 290.936,
+    247.246, 222.73, 192.394, 160.568,
+    139.129, 116.941, 100.741, 73.4232,
+    61.6196, 46.0342, 34.3652, 29.0452,
+    14.9815, 3.71547, -6.44058, -12.0345,
+    -32.6659, -48.0302, -52.1147, -59.5429,
+    -65.0051, -76.2086, -66.8028, -76.5157,
+    -75.4813, -72.975, -62.2129, -72.8316,
+  },
+  {  // p = 15
+    22072.7, 20576, 19145.8, 17784.8,
+    16487.2, 15257.4, 14089.8, 12992.3,
+    11951.5, 10971.1, 10056.5, 9196.64,
+    8395.01, 7647.18, 6959.06, 6316.42,
+    5714.39, 5162.84, 4659.97, 4195.34,
+    3769.94, 3379.54, 3023.5, 2680.31,
+    2383.93, 2118.25, 1873.48, 1652.48,
+    1461.55, 1273.67, 1117.41, 974.785,
+    828.764, 721.692, 621.044, 515.21,
+    455.718, 383.985, 335.636, 274.27,
+    208.803, 144.508, 112.331, 94.9091,
+    53.7722, 53.8161, 29.369, 36.4835,
+    11.5819, 11.9754, 6.36338, -13.216,
+    -17.4638, -37.0851, -36.1633, -48.3872,
+    -67.5765, -89.0986, -106.486, -117.122,
+    -118.157, -129.932, -149.197, -145.156,
+  },
+  {  // p = 16
+    44150.1, 41160.8, 38297.3, 35575.4,
+    32983.3, 30529.7, 28201.5, 26005.9,
+    23934.4, 21978.8, 20152.6, 18449.5,
+    16837.4, 15333.6, 13926.8, 12628.6,
+    11440.2, 10345.4, 9333.12, 8397.41,
+    7557.69, 6777.28, 6066.58, 5415.88,
+    4823.62, 4281.66, 3822.93, 3393.35,
+    2980.07, 2619.95, 2323.79, 2048.57,
+    1805.54, 1568.19, 1386.85, 1205.1,
+    1095.93, 974.02, 865.172, 790.963,
+    674.201, 584.973, 537.016, 442.956,
+    419.01, 367.876, 325.353, 292.101,
+    260.432, 241.103, 230.497, 218.299,
+    202.501, 128.813, 122.96, 128.77,
+    110.973, 98.0456, 89.4353, 41.4912,
+    3.08598, 73.2488, 87.3113, 72.2473,
+  },
+  {  // p = 17
+    88294, 82300.8, 76588.3, 71142,
+    65965.3, 61047.4, 56390.8, 51971.2,
+    47822.6, 43918, 40235.8, 36785,
+    33568.3, 30552.4, 27758.4, 25167.7,
+    22779, 20558.8, 18541.9, 16661.4,
+    14949.5, 13369, 11971.2, 10668,
+    9544.01, 8528.79, 7561.57, 6675.36,
+    5900.65, 5195.86, 4583.66, 3975.93,
+    3548.83, 3105.01, 2624.31, 2236.21,
+    1918.39, 1679.47, 1472.25, 1221.64,
+    1006.74, 934.908, 887.951, 810.241,
+    689.357, 560.581, 429.444, 396.467,
+    353.243, 285.804, 243.553, 97.1675,
+    103.247, 187.833, 303.907, 291.579,
+    257.227, 129.203, 138.514, 125.66,
+    92.7854, 65.2918, 40.6421, 3.37378,
+  },
+  {  // p = 18
+    176587, 164635, 153210, 142307,
+    131936, 122087, 112770, 103970,
+    95680.7, 87854.2, 80533.2, 73664.2,
+    67224.1, 61232, 55680.8, 50502.5,
+    45694.7, 41297.5, 37259.7, 33518.7,
+    30074.4, 26894.2, 24031, 21447.7,
+    19051.2, 16947, 15090, 13307.9,
+    11671.2, 10211.9, 9017.89, 7927,
+    6900.66, 6054.03, 5273.47, 4572.07,
+    4121.83, 3536.51, 2976.01, 2511.72,
+    2088.78, 1598.2, 1266.99, 1068.21,
+    1016.13, 862.402, 599.523, 501.602,
+    302.725, 267.956, 102.013, -43.7042,
+    -137.454, -180.658, -145.24, -228.636,
+    -92.2665, -238.791, -149.874, -240.392,
+    -364.165, -408.27, -385.534, -339.519,
+  },
+};
@@ -0,0 +1,21 @@
+// Copyright 2020 Radu-Stefan Minea 314CA
+
+#ifndef LIBS_HLL_BIAS_H_
+#define LIBS_HLL_BIAS_H_
+
+#include "libs/hll_sketch.h"
+
+#define HLL_PRECISIONS (HLL_MAX_PRECISION - HLL_MIN_PRECISION + 1)
+#define HLL_BIAS_POINTS 64
+
+/*
+ * Empirical bias of the raw HyperLogLog estimate, for every precision:
+ * at cardinality (j + 1) * 6 * 2^p / HLL_BIAS_POINTS, the raw estimate
+ * averages hll_bias_raw[p - HLL_MIN_PRECISION][j], which is too high by
+ * hll_bias_value[p - HLL_MIN_PRECISION][j].
+ * Generated by tools/gen_hll_bias.c (make hll_bias).
+ */
+extern const double hll_bias_raw[HLL_PRECISIONS][HLL_BIAS_POINTS];
+extern const double hll_bias_value[HLL_PRECISIONS][HLL_BIAS_POINTS];
+
+#endif  // LIBS_HLL_BIAS_H_
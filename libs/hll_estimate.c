@@ -0,0 +1,142 @@
+// Copyright 2020 Radu-Stefan Minea 314CA
+
+#include "libs/hll_estimate.h"
+
+#include <math.h>
+
+#include "libs/hll_bias.h"
+#include "libs/hll_sketch.h"
+
+/*
+ * Below these cardinalities linear counting beats the bias-corrected
+ * estimate (one per precision, from HLL_MIN_PRECISION on).
+ * Credits: HyperLogLog in Practice, Heule, Nunkesser, Hall (2013)
+ */
+static const double linear_counting_threshold[HLL_PRECISIONS] = {
+  10, 20, 40, 80, 220, 400, 900, 1800, 3100, 6500, 11500, 20000, 50000,
+  120000, 350000
+};
+
+double hll_raw_estimate(const uint64_t *hist, int precision) {
+  uint64_t m = (uint64_t)1 << precision;
+  double sum = 0;
+
+  for (int r = 0; r <= HLL_MAX_RANK; r++) {
+    sum += ldexp((double)hist[r], -r);
+  }
+
+  return hll_alpha(m) * m * m / sum;
+}
+
+double hll_linear_counting(uint64_t m, uint64_t empty) {
+  return m * log((double)m / empty);
+}
+
+double hll_bias(int precision, double raw) {
+  const double *x = hll_bias_raw[precision - HLL_MIN_PRECISION];
+  const double *y = hll_bias_value[precision - HLL_MIN_PRECISION];
+
+  if (raw <= x[0]) {
+    return y[0];
+  }
+  if (raw >= x[HLL_BIAS_POINTS - 1]) {
+    return 0;
+  }
+
+  // Last point at or below raw, then linear interpolation to the next one
+  int lo = 0, hi = HLL_BIAS_POINTS - 1;
+  while (hi - lo > 1) {
+    int mid = (lo + hi) / 2;
+    if (x[mid] <= raw) {
+      lo = mid;
+    } else {
+      hi = mid;
+    }
+  }
+
+  if (x[hi] == x[lo]) {
+    return y[lo];
+  }
+  return y[lo] + (y[hi] - y[lo]) * (raw - x[lo]) / (x[hi] - x[lo]);
+}
+
+static double plus_plus_estimate(const uint64_t *hist, int precision) {
+  uint64_t m = (uint64_t)1 << precision;
+  double raw = hll_raw_estimate(hist, precision);
+  double estimate = raw;
+
+  if (raw <= 5.0 * m) {
+    estimate = raw - hll_bias(precision, raw);
+  }
+
+  if (hist[0]) {
+    double linear = hll_linear_counting(m, hist[0]);
+    if (linear <= linear_counting_threshold[precision - HLL_MIN_PRECISION]) {
+      return linear;
+    }
+  }
+
+  return estimate;
+}
+
+/*
+ * sigma() and tau() from "New cardinality estimation algorithms for
+ * HyperLogLog sketches", Otmar Ertl (2017): the series are summed until
+ * adding a term doesn't change the result anymore
+ */
+static double sigma(double x) {
+  if (x == 1) {
+    return INFINITY;
+  }
+
+  double y = 1, z = x, old_z;
+  do {
+    x *= x;
+    old_z = z;
+    z += x * y;
+    y += y;
+  } while (z != old_z);
+
+  return z;
+}
+
+static double tau(double x) {
+  if (x == 0 || x == 1) {
+    return 0;
+  }
+
+  double y = 1, z = 1 - x, old_z;
+  do {
+    x = sqrt(x);
+    old_z = z;
+    y *= 0.5;
+    z -= (1 - x) * (1 - x) * y;
+  } while (z != old_z);
+
+  return z / 3;
+}
+
+static double ertl_estimate(const uint64_t *hist, int precision) {
+  uint64_t m = (uint64_t)1 << precision;
+  // q bits are left for the rank => ranks go up to q + 1
+  int q = 64 - precision;
+
+  double z = m * tau(1 - (double)hist[q + 1] / m);
+  for (int r = q; r >= 1; r--) {
+    z = 0.5 * (z + hist[r]);
+  }
+  z += m * sigma((double)hist[0] / m);
+
+  return 0.5 / log(2) * m * m / z;
+}
+
+double hll_estimate(const uint64_t *hist, int precision, int estimator) {
+  switch (estimator) {
+    case HLL_RAW:
+      return hll_raw_estimate(hist, precision);
+    case HLL_PLUS_PLUS:
+      return plus_plus_estimate(hist, precision);
+    default:
+      return ertl_estimate(hist, precision);
+  }
+}
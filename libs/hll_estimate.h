@@ -0,0 +1,42 @@
+// Copyright 2020 Radu-Stefan Minea 314CA
+
+#ifndef LIBS_HLL_ESTIMATE_H_
+#define LIBS_HLL_ESTIMATE_H_
+
+#include <stdint.h>
+
+/*
+ * Cardinality estimates from a register histogram (hist[r] = number of
+ * registers holding rank r, as given by hll_histogram()):
+ * HLL_RAW: the original formula, alpha * m^2 / sum(2^-rank); far off below
+ * about 5m distinct values
+ * HLL_PLUS_PLUS: linear counting while the empty registers make it the
+ * better estimate, the raw estimate minus its empirical bias up to 5m, then
+ * the raw estimate (HyperLogLog++, Heule et al.)
+ * HLL_ERTL: Ertl's improved estimator, which folds the empty and the
+ * saturated registers into the harmonic mean; no tables, accurate across
+ * the whole range
+ */
+enum hll_estimator { HLL_RAW, HLL_PLUS_PLUS, HLL_ERTL };
+
+double hll_estimate(const uint64_t *hist, int precision, int estimator);
+double hll_raw_estimate(const uint64_t *hist, int precision);
+double hll_linear_counting(uint64_t m, uint64_t empty);
+// Empirical bias of a raw estimate (0 above the range of the tables)
+double hll_bias(int precision, double raw);
+
+// alpha_m, the constant of the raw estimate
+static inline double hll_alpha(uint64_t m) {
+  switch (m) {
+    case 16:
+      return 0.673;
+    case 32:
+      return 0.697;
+    case 64:
+      return 0.709;
+    default:
+      return 0.7213 / (1 + 1.079 / m);
+  }
+}
+
+#endif  // LIBS_HLL_ESTIMATE_H_
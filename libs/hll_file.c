@@ -0,0 +1,153 @@
+// Copyright 2020 Radu-Stefan Minea 314CA
+
+#include "libs/hll_file.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "libs/utils.h"
+
+static void file_error(const char *message, const char *path) {
+  fprintf(stderr, "%s: %s\n", message, path);
+  exit(ERROR_STATUS);
+}
+
+static void put_u32(uint8_t *p, uint32_t x) {
+  for (int i = 0; i < 4; i++) {
+    p[i] = x >> (8 * i);
+  }
+}
+
+static uint32_t get_u32(const uint8_t *p) {
+  return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+// Bytes of registers/pairs after the header
+static size_t payload_size(int precision, int layout, uint32_t pairs) {
+  if (layout == HLL_SPARSE) {
+    return (size_t)pairs * 4;
+  }
+  // (Without the padding byte of HLL_PACKED)
+  return ((size_t)1 << precision) * (layout == HLL_DENSE ? 8 : 6) / 8;
+}
+
+void hll_save(Hll *h, const char *path) {
+  hll_flush(h);
+
+  uint32_t pairs = h->layout == HLL_SPARSE ? h->sparse_len : 0;
+  size_t size = payload_size(h->precision, h->layout, pairs);
+  uint8_t *data = malloc(HLL_HEADER_SIZE + size);
+  mem_check(data);
+
+  memcpy(data, HLL_FILE_MAGIC, 4);
+  data[4] = HLL_FILE_VERSION;
+  data[5] = h->precision;
+  data[6] = h->layout;
+  data[7] = 0;
+  put_u32(data + 8, pairs);
+
+  if (h->layout == HLL_SPARSE) {
+    for (uint32_t i = 0; i < pairs; i++) {
+      put_u32(data + HLL_HEADER_SIZE + 4 * i, h->sparse[i]);
+    }
+  } else {
+    memcpy(data + HLL_HEADER_SIZE, h->registers, size);
+  }
+
+  FILE *f = fopen(path, "wb");
+  if (f == NULL) {
+    file_error("Couldn't create sketch file", path);
+  }
+  if (fwrite(data, 1, HLL_HEADER_SIZE + size, f) != HLL_HEADER_SIZE + size ||
+      fclose(f)) {
+    file_error("Error writing sketch file", path);
+  }
+
+  free(data);
+}
+
+// Whole file in memory; *size = its length
+static uint8_t *read_file(const char *path, size_t *size) {
+  FILE *f = fopen(path, "rb");
+  if (f == NULL) {
+    file_error("Couldn't open sketch file", path);
+  }
+
+  size_t cap = 1 << 12;
+  uint8_t *data = malloc(cap);
+  mem_check(data);
+  *size = 0;
+
+  size_t cnt;
+  while ((cnt = fread(data + *size, 1, cap - *size, f)) > 0) {
+    *size += cnt;
+    if (*size == cap) {
+      cap *= 2;
+      data = realloc(data, cap);
+      mem_check(data);
+    }
+  }
+
+  if (ferror(f)) {
+    file_error("Error reading sketch file", path);
+  }
+  fclose(f);
+  return data;
+}
+
+void hll_load(Hll *h, const char *path) {
+  size_t size;
+  uint8_t *data = read_file(path, &size);
+
+  if (size < HLL_HEADER_SIZE || memcmp(data, HLL_FILE_MAGIC, 4) ||
+      data[4] != HLL_FILE_VERSION) {
+    file_error("Not a sketch file", path);
+  }
+
+  int precision = data[5], layout = data[6];
+  uint32_t pairs = get_u32(data + 8);
+  if (precision < HLL_MIN_PRECISION || precision > HLL_MAX_PRECISION ||
+      layout < HLL_DENSE || layout > HLL_SPARSE ||
+      (layout != HLL_SPARSE && pairs) ||
+      pairs > ((uint32_t)1 << precision) ||
+      size != HLL_HEADER_SIZE + payload_size(precision, layout, pairs)) {
+    file_error("Corrupt sketch file", path);
+  }
+
+  const uint8_t *payload = data + HLL_HEADER_SIZE;
+  uint32_t m = (uint32_t)1 << precision;
+  int max_rank = 64 - precision + 1;
+
+  if (layout == HLL_SPARSE) {
+    init_hll(h, precision, HLL_PACKED, 1);
+    h->sparse_cap = pairs ? pairs : 1;
+    h->sparse = malloc(h->sparse_cap * sizeof(uint32_t));
+    mem_check(h->sparse);
+
+    for (uint32_t i = 0; i < pairs; i++) {
+      uint32_t pair = get_u32(payload + 4 * i);
+      uint32_t index = pair >> HLL_REGISTER_BITS;
+      int rank = pair & ((1 << HLL_REGISTER_BITS) - 1);
+
+      // Strictly increasing indexes, valid ranks
+      if (index >= m || rank < 1 || rank > max_rank ||
+          (i && index <= h->sparse[i - 1] >> HLL_REGISTER_BITS)) {
+        file_error("Corrupt sketch file", path);
+      }
+      h->sparse[i] = pair;
+    }
+    h->sparse_len = pairs;
+  } else {
+    init_hll(h, precision, layout, 0);
+    memcpy(h->registers, payload, payload_size(precision, layout, 0));
+
+    for (uint32_t i = 0; i < m; i++) {
+      if (hll_get(h, i) > max_rank) {
+        file_error("Corrupt sketch file", path);
+      }
+    }
+  }
+
+  free(data);
+}
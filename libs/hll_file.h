@@ -0,0 +1,28 @@
+// Copyright 2020 Radu-Stefan Minea 314CA
+
+#ifndef LIBS_HLL_FILE_H_
+#define LIBS_HLL_FILE_H_
+
+#include "libs/hll_sketch.h"
+
+/*
+ * Sketch files, in whichever layout the sketch has:
+ * bytes 0-3: "HLLS"
+ * byte 4: format version (HLL_FILE_VERSION)
+ * byte 5: precision
+ * byte 6: layout (enum hll_layout)
+ * byte 7: 0
+ * bytes 8-11: number of sparse pairs (0 for the dense layouts)
+ * then the registers: HLL_DENSE => 2^p bytes, HLL_PACKED => 2^p * 6 / 8
+ * bytes (register i in bits 6i..6i+5, little endian), HLL_SPARSE => the
+ * sorted pairs, 4 bytes each (index << 6 | rank, little endian)
+ */
+#define HLL_FILE_MAGIC "HLLS"
+#define HLL_FILE_VERSION 1
+#define HLL_HEADER_SIZE 12
+
+void hll_save(Hll *h, const char *path);
+// Exits with an error message if the file isn't a valid sketch
+void hll_load(Hll *h, const char *path);
+
+#endif  // LIBS_HLL_FILE_H_
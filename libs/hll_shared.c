@@ -0,0 +1,60 @@
+// Copyright 2020 Radu-Stefan Minea 314CA
+
+#include "libs/hll_shared.h"
+
+#include <stdlib.h>
+
+#include "libs/hll_batch.h"
+#include "libs/utils.h"
+
+void init_hll_shared(HllShared *s, int precision) {
+  if (s == NULL) {
+    return;
+  }
+
+  uint32_t m = (uint32_t)1 << precision;
+  s->precision = precision;
+  s->no_words = (m + HLL_SHARED_PER_WORD - 1) / HLL_SHARED_PER_WORD;
+  s->words = malloc(s->no_words * sizeof(*s->words));
+  mem_check((void *)s->words);
+
+  for (size_t i = 0; i < s->no_words; i++) {
+    atomic_init(&s->words[i], 0);
+  }
+}
+
+void hll_shared_add_batch(HllShared *s, const int64_t *values, size_t n) {
+  uint32_t index[HLL_BATCH_SIZE];
+  uint8_t rank[HLL_BATCH_SIZE];
+
+  for (size_t done = 0; done < n; done += HLL_BATCH_SIZE) {
+    size_t count = n - done < HLL_BATCH_SIZE ? n - done : HLL_BATCH_SIZE;
+
+    hll_hash_batch(values + done, count, s->precision, index, rank);
+    for (size_t i = 0; i < count; i++) {
+      hll_shared_update(s, index[i], rank[i]);
+    }
+  }
+}
+
+void hll_shared_merge(HllShared *s, Hll *h) {
+  uint32_t m = (uint32_t)1 << s->precision;
+
+  for (uint32_t i = 0; i < m; i++) {
+    uint32_t word = atomic_load(&s->words[i / HLL_SHARED_PER_WORD]);
+    unsigned int shift = i % HLL_SHARED_PER_WORD * HLL_REGISTER_BITS;
+    int rank = (word >> shift) & ((1u << HLL_REGISTER_BITS) - 1);
+    if (rank) {
+      hll_update(h, i, rank);
+    }
+  }
+}
+
+void free_hll_shared(HllShared *s) {
+  if (s == NULL) {
+    return;
+  }
+
+  free((void *)s->words);
+  s->words = NULL;
+}
@@ -0,0 +1,59 @@
+// Copyright 2020 Radu-Stefan Minea 314CA
+
+#ifndef LIBS_HLL_SHARED_H_
+#define LIBS_HLL_SHARED_H_
+
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "libs/hll_sketch.h"
+
+// 5 registers of 6 bits in every 32-bit word (the top 2 bits are unused)
+#define HLL_SHARED_PER_WORD 5
+
+/*
+ * Registers that several threads update at once, without locks: a
+ * register never straddles two words, so raising it is a compare-and-swap
+ * loop on its word (atomic fetch-max), retried only when another thread
+ * changed the same word in between.
+ */
+typedef struct HllShared {
+  int precision;
+  _Atomic uint32_t *words;
+  size_t no_words;
+} HllShared;
+
+void init_hll_shared(HllShared *s, int precision);
+void hll_shared_add_batch(HllShared *s, const int64_t *values, size_t n);
+// h = max(h, s), register by register; a sparse h stays sparse while the
+// registers that aren't 0 fit, like after adding them one by one
+void hll_shared_merge(HllShared *s, Hll *h);
+void free_hll_shared(HllShared *s);
+
+static inline void hll_shared_update(HllShared *s, uint32_t index, int rank) {
+  _Atomic uint32_t *word = s->words + index / HLL_SHARED_PER_WORD;
+  unsigned int shift = index % HLL_SHARED_PER_WORD * HLL_REGISTER_BITS;
+  uint32_t mask = ((1u << HLL_REGISTER_BITS) - 1) << shift;
+  uint32_t old = atomic_load_explicit(word, memory_order_relaxed);
+
+  // On failure, old is reloaded with the word's current value
+  while (((old & mask) >> shift) < (uint32_t)rank) {
+    uint32_t raised = (old & ~mask) | ((uint32_t)rank << shift);
+    if (atomic_compare_exchange_weak_explicit(word, &old, raised,
+                                              memory_order_relaxed,
+                                              memory_order_relaxed)) {
+      return;
+    }
+  }
+}
+
+static inline void hll_shared_add_hash(HllShared *s, uint64_t hash) {
+  uint32_t index;
+  int rank;
+
+  hll_hash_position(hash, s->precision, &index, &rank);
+  hll_shared_update(s, index, rank);
+}
+
+#endif  // LIBS_HLL_SHARED_H_
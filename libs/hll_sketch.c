@@ -0,0 +1,330 @@
+// Copyright 2020 Radu-Stefan Minea 314CA
+
+#include "libs/hll_sketch.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+#if defined(__GNUC__) && defined(__x86_64__)
+#include <immintrin.h>
+#define HAVE_AVX2_DISPATCH
+#endif
+
+#include "libs/utils.h"
+
+#define MIN_SPARSE_CAP 8
+
+// (index, rank) pair: sorting pairs sorts by index, then by rank
+static inline uint32_t pack_pair(uint32_t index, int rank) {
+  return (index << HLL_REGISTER_BITS) | rank;
+}
+
+static inline uint32_t pair_index(uint32_t pair) {
+  return pair >> HLL_REGISTER_BITS;
+}
+
+static inline int pair_rank(uint32_t pair) {
+  return pair & ((1 << HLL_REGISTER_BITS) - 1);
+}
+
+size_t hll_dense_size(int precision, int layout) {
+  size_t m = (size_t)1 << precision;
+
+  if (layout == HLL_DENSE) {
+    return m;
+  }
+  // + 1 byte, so the 16-bit window of the last register stays inside
+  return m * HLL_REGISTER_BITS / 8 + 1;
+}
+
+void init_hll(Hll *h, int precision, int dense_layout, int sparse) {
+  if (h == NULL) {
+    return;
+  }
+
+  h->precision = precision;
+  h->dense_layout = dense_layout;
+  h->registers = NULL;
+  h->sparse = NULL;
+  h->sparse_len = 0;
+  h->pending_len = 0;
+  h->sparse_cap = 0;
+
+  if (sparse) {
+    h->layout = HLL_SPARSE;
+    return;
+  }
+
+  h->layout = dense_layout;
+  h->registers = calloc(hll_dense_size(precision, dense_layout), 1);
+  mem_check(h->registers);
+}
+
+static int compare_pairs(const void *a, const void *b) {
+  uint32_t x = *(const uint32_t *)a, y = *(const uint32_t *)b;
+  return (x > y) - (x < y);
+}
+
+// Index of the sorted pair of register index, or -1
+static int64_t find_sorted(const Hll *h, uint32_t index) {
+  int64_t lo = 0, hi = (int64_t)h->sparse_len - 1;
+
+  while (lo <= hi) {
+    int64_t mid = (lo + hi) / 2;
+    uint32_t mid_index = pair_index(h->sparse[mid]);
+
+    if (mid_index == index) {
+      return mid;
+    }
+    if (mid_index < index) {
+      lo = mid + 1;
+    } else {
+      hi = mid - 1;
+    }
+  }
+
+  return -1;
+}
+
+// Sorts the pending pairs in, keeping only the highest rank of every index
+static void merge_pending(Hll *h) {
+  uint32_t total = h->sparse_len + h->pending_len;
+  uint32_t len = 0;
+
+  // A sketch never updated has no array yet (qsort(NULL, ...) is undefined)
+  if (total == 0) {
+    return;
+  }
+
+  qsort(h->sparse, total, sizeof(uint32_t), compare_pairs);
+  for (uint32_t i = 0; i < total; i++) {
+    // Same index as the next pair => it has a higher (or equal) rank
+    if (i + 1 < total &&
+        pair_index(h->sparse[i]) == pair_index(h->sparse[i + 1])) {
+      continue;
+    }
+    h->sparse[len++] = h->sparse[i];
+  }
+
+  h->sparse_len = len;
+  h->pending_len = 0;
+}
+
+static void convert_to_dense(Hll *h) {
+  merge_pending(h);
+
+  uint32_t *pairs = h->sparse;
+  uint32_t len = h->sparse_len;
+
+  h->layout = h->dense_layout;
+  h->registers = calloc(hll_dense_size(h->precision, h->layout), 1);
+  mem_check(h->registers);
+  for (uint32_t i = 0; i < len; i++) {
+    hll_update(h, pair_index(pairs[i]), pair_rank(pairs[i]));
+  }
+
+  free(pairs);
+  h->sparse = NULL;
+  h->sparse_len = 0;
+  h->sparse_cap = 0;
+}
+
+void hll_flush(Hll *h) {
+  if (h->layout == HLL_SPARSE) {
+    merge_pending(h);
+  }
+}
+
+void hll_convert(Hll *h, int layout) {
+  if (h->layout == layout) {
+    return;
+  }
+
+  if (h->layout == HLL_SPARSE) {
+    h->dense_layout = layout;
+    convert_to_dense(h);
+    return;
+  }
+
+  // Between the two dense layouts: copying register by register
+  Hll old = *h;
+  h->layout = h->dense_layout = layout;
+  h->registers = calloc(hll_dense_size(h->precision, layout), 1);
+  mem_check(h->registers);
+
+  uint32_t m = (uint32_t)1 << h->precision;
+  for (uint32_t i = 0; i < m; i++) {
+    hll_update(h, i, hll_get(&old, i));
+  }
+  free(old.registers);
+}
+
+// 4 registers in every 3 bytes (m is a multiple of 4)
+static void unpack_registers(const uint8_t *packed, uint8_t *out, uint32_t m) {
+  for (uint32_t i = 0; i < m; i += 4, packed += 3) {
+    out[i] = packed[0] & 0x3F;
+    out[i + 1] = (packed[0] >> 6) | ((packed[1] & 0x0F) << 2);
+    out[i + 2] = (packed[1] >> 4) | ((packed[2] & 0x03) << 4);
+    out[i + 3] = packed[2] >> 2;
+  }
+}
+
+// dst[i] = max(dst[i], src[i])
+static void max_bytes(uint8_t *dst, const uint8_t *src, size_t n) {
+  size_t i = 0;
+
+#ifdef __SSE2__
+  for (; i + 16 <= n; i += 16) {
+    __m128i a = _mm_loadu_si128((const __m128i *)(dst + i));
+    __m128i b = _mm_loadu_si128((const __m128i *)(src + i));
+    _mm_storeu_si128((__m128i *)(dst + i), _mm_max_epu8(a, b));
+  }
+#endif
+
+  for (; i < n; i++) {
+    if (dst[i] < src[i]) {
+      dst[i] = src[i];
+    }
+  }
+}
+
+#ifdef HAVE_AVX2_DISPATCH
+__attribute__((target("avx2")))
+static void max_bytes_avx2(uint8_t *dst, const uint8_t *src, size_t n) {
+  size_t i = 0;
+
+  for (; i + 32 <= n; i += 32) {
+    __m256i a = _mm256_loadu_si256((const __m256i *)(dst + i));
+    __m256i b = _mm256_loadu_si256((const __m256i *)(src + i));
+    _mm256_storeu_si256((__m256i *)(dst + i), _mm256_max_epu8(a, b));
+  }
+
+  max_bytes(dst + i, src + i, n - i);
+}
+#endif
+
+void hll_merge(Hll *h, Hll *other) {
+  uint32_t m = (uint32_t)1 << h->precision;
+
+  if (other->layout == HLL_SPARSE) {
+    merge_pending(other);
+    for (uint32_t i = 0; i < other->sparse_len; i++) {
+      hll_update(h, pair_index(other->sparse[i]),
+                 pair_rank(other->sparse[i]));
+    }
+    return;
+  }
+
+  // Whole register arrays => one byte per register, maxed 16/32 at a time
+  hll_convert(h, HLL_DENSE);
+
+  const uint8_t *src = other->registers;
+  uint8_t *unpacked = NULL;
+  if (other->layout == HLL_PACKED) {
+    unpacked = malloc(m);
+    mem_check(unpacked);
+    unpack_registers(other->registers, unpacked, m);
+    src = unpacked;
+  }
+
+#ifdef HAVE_AVX2_DISPATCH
+  static int has_avx2 = -1;
+  if (has_avx2 < 0) {
+    has_avx2 = __builtin_cpu_supports("avx2");
+  }
+  if (has_avx2) {
+    max_bytes_avx2(h->registers, src, m);
+  } else {
+    max_bytes(h->registers, src, m);
+  }
+#else
+  max_bytes(h->registers, src, m);
+#endif
+
+  free(unpacked);
+}
+
+int hll_get_slow(Hll *h, uint32_t index) {
+  int rank = 0;
+
+  int64_t pos = find_sorted(h, index);
+  if (pos >= 0) {
+    rank = pair_rank(h->sparse[pos]);
+  }
+
+  uint32_t *pending = h->sparse + h->sparse_len;
+  for (uint32_t i = 0; i < h->pending_len; i++) {
+    if (pair_index(pending[i]) == index && pair_rank(pending[i]) > rank) {
+      rank = pair_rank(pending[i]);
+    }
+  }
+
+  return rank;
+}
+
+void hll_update_slow(Hll *h, uint32_t index, int rank) {
+  // Most updates don't raise the register => only a binary search
+  int64_t pos = find_sorted(h, index);
+  if (pos >= 0 && pair_rank(h->sparse[pos]) >= rank) {
+    return;
+  }
+
+  if (h->sparse_len + h->pending_len == h->sparse_cap) {
+    h->sparse_cap = h->sparse_cap ? 2 * h->sparse_cap : MIN_SPARSE_CAP;
+    h->sparse = realloc(h->sparse, h->sparse_cap * sizeof(uint32_t));
+    mem_check(h->sparse);
+  }
+  h->sparse[h->sparse_len + h->pending_len++] = pack_pair(index, rank);
+
+  // Sorting once the pending pairs are 1/8 of the sorted ones, so every
+  // pair is sorted in a constant number of times on average
+  if (h->pending_len > h->sparse_len / 8 + MIN_SPARSE_CAP) {
+    merge_pending(h);
+  }
+
+  // Pairs would take more memory than the registers themselves
+  if (h->sparse_cap * sizeof(uint32_t) >
+      hll_dense_size(h->precision, h->dense_layout)) {
+    convert_to_dense(h);
+  }
+}
+
+void hll_histogram(Hll *h, uint64_t *hist) {
+  uint32_t m = (uint32_t)1 << h->precision;
+
+  memset(hist, 0, (HLL_MAX_RANK + 1) * sizeof(uint64_t));
+
+  if (h->layout == HLL_SPARSE) {
+    merge_pending(h);
+    hist[0] = m - h->sparse_len;
+    for (uint32_t i = 0; i < h->sparse_len; i++) {
+      hist[pair_rank(h->sparse[i])]++;
+    }
+    return;
+  }
+
+  for (uint32_t i = 0; i < m; i++) {
+    hist[hll_get(h, i)]++;
+  }
+}
+
+size_t hll_size(const Hll *h) {
+  if (h->layout == HLL_SPARSE) {
+    return h->sparse_cap * sizeof(uint32_t);
+  }
+  return hll_dense_size(h->precision, h->layout);
+}
+
+void free_hll(Hll *h) {
+  if (h == NULL) {
+    return;
+  }
+
+  free(h->registers);
+  free(h->sparse);
+  h->registers = NULL;
+  h->sparse = NULL;
+}
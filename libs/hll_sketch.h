@@ -0,0 +1,113 @@
+// Copyright 2020 Radu-Stefan Minea 314CA
+
+#ifndef LIBS_HLL_SKETCH_H_
+#define LIBS_HLL_SKETCH_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define HLL_MIN_PRECISION 4
+#define HLL_MAX_PRECISION 18
+// Highest rank: 64 - HLL_MIN_PRECISION + 1 = 61, so 6 bits are enough
+#define HLL_REGISTER_BITS 6
+#define HLL_MAX_RANK (64 - HLL_MIN_PRECISION + 1)
+
+/*
+ * HyperLogLog registers (2^precision of them) in one of three layouts:
+ * HLL_DENSE: one byte per register
+ * HLL_PACKED: 6 bits per register, 3/4 of the memory of HLL_DENSE
+ * HLL_SPARSE: only the registers that aren't 0, as (index, rank) pairs
+ * packed in 32 bits: sparse_len sorted ones, followed by pending_len new
+ * ones that get sorted in once there are enough of them. Once the pairs
+ * would take more memory than dense_layout, the sketch converts itself.
+ */
+enum hll_layout { HLL_DENSE, HLL_PACKED, HLL_SPARSE };
+
+typedef struct Hll {
+  int precision;
+  int layout;
+  int dense_layout;  // What a sparse sketch becomes
+  uint8_t *registers;  // HLL_DENSE and HLL_PACKED
+  uint32_t *sparse;
+  uint32_t sparse_len, pending_len, sparse_cap;
+} Hll;
+
+// dense_layout is HLL_DENSE or HLL_PACKED; sparse => starts as HLL_SPARSE
+void init_hll(Hll *h, int precision, int dense_layout, int sparse);
+int hll_get_slow(Hll *h, uint32_t index);
+void hll_update_slow(Hll *h, uint32_t index, int rank);
+// hist[r] = number of registers holding rank r, for r in [0, HLL_MAX_RANK]
+void hll_histogram(Hll *h, uint64_t *hist);
+// Sorts the pending pairs of a sparse sketch in
+void hll_flush(Hll *h);
+// To HLL_DENSE or HLL_PACKED, keeping every register
+void hll_convert(Hll *h, int layout);
+/*
+ * h = max(h, other), register by register (same precision). A sparse other
+ * is added pair by pair; otherwise h becomes HLL_DENSE and the registers are
+ * maxed with SIMD, 16 or 32 at a time.
+ */
+void hll_merge(Hll *h, Hll *other);
+size_t hll_dense_size(int precision, int layout);
+// Memory taken by the registers, in bytes
+size_t hll_size(const Hll *h);
+void free_hll(Hll *h);
+
+static inline int hll_get(Hll *h, uint32_t index) {
+  if (h->layout == HLL_DENSE) {
+    return h->registers[index];
+  }
+  if (h->layout == HLL_PACKED) {
+    // The register sits in the 16 bits starting at byte offset / 8
+    uint32_t offset = index * HLL_REGISTER_BITS;
+    const uint8_t *p = h->registers + offset / 8;
+    unsigned int window = p[0] | (p[1] << 8);
+    return (window >> (offset % 8)) & ((1 << HLL_REGISTER_BITS) - 1);
+  }
+  return hll_get_slow(h, index);
+}
+
+// register[index] = max(register[index], rank)
+static inline void hll_update(Hll *h, uint32_t index, int rank) {
+  if (h->layout == HLL_DENSE) {
+    if (h->registers[index] < rank) {
+      h->registers[index] = rank;
+    }
+    return;
+  }
+  if (h->layout == HLL_PACKED) {
+    uint32_t offset = index * HLL_REGISTER_BITS;
+    uint8_t *p = h->registers + offset / 8;
+    unsigned int window = p[0] | (p[1] << 8);
+    unsigned int shift = offset % 8;
+    unsigned int mask = ((1u << HLL_REGISTER_BITS) - 1) << shift;
+
+    if (((window & mask) >> shift) < (unsigned int)rank) {
+      window = (window & ~mask) | ((unsigned int)rank << shift);
+      p[0] = window;
+      p[1] = window >> 8;
+    }
+    return;
+  }
+  hll_update_slow(h, index, rank);
+}
+
+// The first precision bits of hash pick the register, the rest the rank
+static inline void hll_hash_position(uint64_t hash, int precision,
+                                     uint32_t *index, int *rank) {
+  *index = hash >> (64 - precision);
+  // Position of the first 1 after the index bits; the extra 1 stops the
+  // count at 64 - precision + 1 when they're all 0
+  uint64_t rest = (hash << precision) | ((uint64_t)1 << (precision - 1));
+  *rank = __builtin_clzll(rest) + 1;
+}
+
+static inline void hll_add_hash(Hll *h, uint64_t hash) {
+  uint32_t index;
+  int rank;
+
+  hll_hash_position(hash, h->precision, &index, &rank);
+  hll_update(h, index, rank);
+}
+
+#endif  // LIBS_HLL_SKETCH_H_
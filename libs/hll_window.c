@@ -0,0 +1,100 @@
+// Copyright 2020 Radu-Stefan Minea 314CA
+
+#include "libs/hll_window.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "libs/utils.h"
+
+#define RANK_MASK ((1u << HLL_REGISTER_BITS) - 1)
+#define MIN_PAIRS 2
+
+static inline uint64_t pair_time(uint64_t pair) {
+  return pair >> HLL_REGISTER_BITS;
+}
+
+static inline int pair_rank(uint64_t pair) {
+  return pair & RANK_MASK;
+}
+
+// Is time older than the window (of len units) ending at now?
+static inline int expired(uint64_t time, uint64_t now, uint64_t len) {
+  return now - time >= len;
+}
+
+void init_hll_window(HllWindow *w, int precision, uint64_t length) {
+  if (w == NULL) {
+    return;
+  }
+
+  w->precision = precision;
+  w->length = length;
+  w->registers = calloc((size_t)1 << precision, sizeof(window_register));
+  mem_check(w->registers);
+}
+
+void hll_window_add_hash(HllWindow *w, uint64_t hash, uint64_t time) {
+  uint32_t index;
+  int rank;
+  hll_hash_position(hash, w->precision, &index, &rank);
+
+  window_register *reg = &w->registers[index];
+
+  // Pairs that fell out of the window (the oldest ones come first)
+  int old = 0;
+  while (old < reg->len && expired(pair_time(reg->pairs[old]), time,
+                                   w->length)) {
+    old++;
+  }
+  if (old) {
+    reg->len -= old;
+    memmove(reg->pairs, reg->pairs + old, reg->len * sizeof(uint64_t));
+  }
+
+  // Older pairs that aren't higher can never be a maximum again
+  while (reg->len && pair_rank(reg->pairs[reg->len - 1]) <= rank) {
+    reg->len--;
+  }
+
+  // Ranks strictly decrease => at most HLL_MAX_RANK pairs
+  if (reg->len == reg->cap) {
+    reg->cap = reg->cap ? 2 * reg->cap : MIN_PAIRS;
+    reg->pairs = realloc(reg->pairs, reg->cap * sizeof(uint64_t));
+    mem_check(reg->pairs);
+  }
+  reg->pairs[reg->len++] = (time << HLL_REGISTER_BITS) | rank;
+}
+
+void hll_window_histogram(HllWindow *w, uint64_t now, uint64_t len,
+                          uint64_t *hist) {
+  uint32_t m = (uint32_t)1 << w->precision;
+
+  memset(hist, 0, (HLL_MAX_RANK + 1) * sizeof(uint64_t));
+  for (uint32_t i = 0; i < m; i++) {
+    window_register *reg = &w->registers[i];
+    int rank = 0;
+
+    // First pair inside the window = highest rank inside it
+    for (int j = 0; j < reg->len; j++) {
+      if (!expired(pair_time(reg->pairs[j]), now, len)) {
+        rank = pair_rank(reg->pairs[j]);
+        break;
+      }
+    }
+    hist[rank]++;
+  }
+}
+
+void free_hll_window(HllWindow *w) {
+  if (w == NULL) {
+    return;
+  }
+
+  uint32_t m = (uint32_t)1 << w->precision;
+  for (uint32_t i = 0; i < m; i++) {
+    free(w->registers[i].pairs);
+  }
+  free(w->registers);
+  w->registers = NULL;
+}
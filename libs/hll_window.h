@@ -0,0 +1,40 @@
+// Copyright 2020 Radu-Stefan Minea 314CA
+
+#ifndef LIBS_HLL_WINDOW_H_
+#define LIBS_HLL_WINDOW_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "libs/hll_sketch.h"
+
+/*
+ * Sliding-window HyperLogLog: every register keeps, instead of one rank,
+ * the (time, rank) pairs that could still be its maximum in some window
+ * ending now: sorted by time, with strictly decreasing ranks (a pair older
+ * and not higher than a newer one can never be the maximum again). Pairs
+ * older than length are dropped. The rank of a register over the last L
+ * time units is the first pair newer than now - L, so a window query is
+ * O(m) and any L <= length can be asked without re-reading the input.
+ * Times are any non-decreasing 58-bit values (record numbers,
+ * milliseconds, ...).
+ */
+typedef struct window_register {
+  uint64_t *pairs;  // time << 6 | rank
+  uint8_t len, cap;
+} window_register;
+
+typedef struct HllWindow {
+  int precision;
+  uint64_t length;
+  window_register *registers;
+} HllWindow;
+
+void init_hll_window(HllWindow *w, int precision, uint64_t length);
+void hll_window_add_hash(HllWindow *w, uint64_t hash, uint64_t time);
+// Rank histogram (see hll_histogram()) of the values in (now - len, now]
+void hll_window_histogram(HllWindow *w, uint64_t now, uint64_t len,
+                          uint64_t *hist);
+void free_hll_window(HllWindow *w);
+
+#endif  // LIBS_HLL_WINDOW_H_
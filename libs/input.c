@@ -0,0 +1,237 @@
+// Copyright 2020 Radu-Stefan Minea 314CA
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "libs/input.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "libs/utils.h"
+
+// Same characters as isspace() in the "C" locale
+static inline int is_space(char c) {
+  return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+static Input *alloc_input(void) {
+  Input *in = calloc(1, sizeof(Input));
+  mem_check(in);
+  in->fd = -1;
+  return in;
+}
+
+Input *open_input(const char *path) {
+  Input *in = alloc_input();
+
+  if (path == NULL) {
+    in->fd = STDIN_FILENO;
+  } else {
+    in->fd = open(path, O_RDONLY);
+    if (in->fd < 0) {
+      fprintf(stderr, "Couldn't open input file\n");
+      exit(ERROR_STATUS);
+    }
+  }
+
+  // Regular file => mapping it whole
+  struct stat st;
+  if (fstat(in->fd, &st) == 0 && S_ISREG(st.st_mode)) {
+    in->mapped = 1;
+    in->eof = 1;
+    in->size = st.st_size;
+    if (in->size > 0) {
+      void *data = mmap(NULL, in->size, PROT_READ, MAP_PRIVATE, in->fd, 0);
+      if (data == MAP_FAILED) {
+        fprintf(stderr, "Couldn't map input file\n");
+        exit(ERROR_STATUS);
+      }
+      posix_madvise(data, in->size, POSIX_MADV_SEQUENTIAL);
+      in->data = data;
+    }
+    return in;
+  }
+
+  in->buffer_cap = INPUT_BLOCK_SIZE;
+  in->buffer = malloc(in->buffer_cap);
+  mem_check(in->buffer);
+  in->data = in->buffer;
+  return in;
+}
+
+Input *input_range(Input *in, size_t start, size_t end) {
+  Input *range = alloc_input();
+
+  range->mapped = 1;
+  range->eof = 1;
+  range->data = in->data + start;
+  range->size = end - start;
+  return range;
+}
+
+size_t next_line_start(Input *in, size_t pos) {
+  if (pos == 0) {
+    return 0;
+  }
+
+  while (pos < in->size && in->data[pos - 1] != '\n') {
+    pos++;
+  }
+  return pos;
+}
+
+/*
+ * Keeps the unread bytes (from pos on) at the start of the buffer and reads
+ * more after them. Returns the number of bytes read.
+ */
+static size_t refill(Input *in) {
+  if (in->eof) {
+    return 0;
+  }
+
+  size_t left = in->size - in->pos;
+  memmove(in->buffer, in->buffer + in->pos, left);
+  in->size = left;
+  in->pos = 0;
+
+  // A token as long as the whole buffer => making room for it
+  if (in->size == in->buffer_cap) {
+    in->buffer_cap *= 2;
+    in->buffer = realloc(in->buffer, in->buffer_cap);
+    mem_check(in->buffer);
+    in->data = in->buffer;
+  }
+
+  ssize_t cnt;
+  do {
+    cnt = read(in->fd, in->buffer + in->size, in->buffer_cap - in->size);
+  } while (cnt < 0 && errno == EINTR);
+
+  if (cnt <= 0) {
+    in->eof = 1;
+    return 0;
+  }
+
+  in->size += cnt;
+  return cnt;
+}
+
+int next_token(Input *in, const char **token, size_t *len) {
+  // Skipping whitespace
+  while (1) {
+    while (in->pos < in->size && is_space(in->data[in->pos])) {
+      in->pos++;
+    }
+    if (in->pos < in->size) {
+      break;
+    }
+    if (!refill(in)) {
+      return 0;
+    }
+  }
+
+  // Token ends at the next whitespace; if that isn't in the buffer yet,
+  // reading more (the token is moved to the start of the buffer)
+  size_t end = in->pos;
+  while (1) {
+    while (end < in->size && !is_space(in->data[end])) {
+      end++;
+    }
+    if (end < in->size) {
+      break;
+    }
+
+    // refill moves the token even when it reads nothing
+    size_t token_len = end - in->pos;
+    int more = refill(in) > 0;
+    end = in->pos + token_len;
+    if (!more) {
+      break;
+    }
+  }
+
+  *token = in->data + in->pos;
+  *len = end - in->pos;
+  in->pos = end;
+  return 1;
+}
+
+int next_record(Input *in, size_t width, const char **record) {
+  while (in->size - in->pos < width) {
+    if (!refill(in)) {
+      if (in->pos < in->size) {
+        fprintf(stderr, "Input ends with a partial record (%zu bytes)\n",
+                in->size - in->pos);
+        exit(ERROR_STATUS);
+      }
+      return 0;
+    }
+  }
+
+  *record = in->data + in->pos;
+  in->pos += width;
+  return 1;
+}
+
+static void invalid_int(const char *token, size_t len) {
+  fprintf(stderr, "Invalid integer in input: %.*s\n", (int)len, token);
+  exit(ERROR_STATUS);
+}
+
+int next_int(Input *in, int64_t *x) {
+  const char *token;
+  size_t len;
+
+  if (!next_token(in, &token, &len)) {
+    return 0;
+  }
+
+  size_t i = 0;
+  int negative = 0;
+  if (token[0] == '-' || token[0] == '+') {
+    negative = token[0] == '-';
+    i++;
+  }
+  if (i == len) {
+    invalid_int(token, len);
+  }
+
+  // INT64_MIN has no positive counterpart => adding up in unsigned
+  uint64_t limit = (uint64_t)INT64_MAX + negative;
+  uint64_t value = 0;
+  for (; i < len; i++) {
+    unsigned int digit = (unsigned char)token[i] - '0';
+    if (digit > 9 || value > (limit - digit) / 10) {
+      invalid_int(token, len);
+    }
+    value = value * 10 + digit;
+  }
+
+  *x = negative ? (int64_t)(0 - value) : (int64_t)value;
+  return 1;
+}
+
+void close_input(Input *in) {
+  if (in == NULL) {
+    return;
+  }
+
+  // Ranges don't own anything but the struct
+  if (in->fd >= 0) {
+    if (in->mapped && in->size > 0) {
+      munmap((void *)in->data, in->size);
+    }
+    if (in->fd != STDIN_FILENO) {
+      close(in->fd);
+    }
+  }
+
+  free(in->buffer);
+  free(in);
+}
@@ -0,0 +1,42 @@
+// Copyright 2020 Radu-Stefan Minea 314CA
+
+#ifndef LIBS_INPUT_H_
+#define LIBS_INPUT_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define INPUT_BLOCK_SIZE (1 << 20)
+
+/*
+ * Whitespace-separated tokens, handed out as (pointer, length) views.
+ * Regular files are mmap-ed, so a token points straight into the file and
+ * stays valid until close_input(). Anything else (pipes, terminals) is read
+ * in blocks of INPUT_BLOCK_SIZE, and a token is only valid until the next
+ * call.
+ */
+typedef struct Input {
+  const char *data;
+  size_t size;  // Bytes available in data
+  size_t pos;
+  int fd;  // -1 for ranges, which only borrow data from another Input
+  int mapped;  // data holds the whole input
+  int eof;
+  char *buffer;  // Only used when reading blocks
+  size_t buffer_cap;
+} Input;
+
+// path == NULL => stdin
+Input *open_input(const char *path);
+// View of bytes [start, end) of a mapped input
+Input *input_range(Input *in, size_t start, size_t end);
+// First position >= pos that starts a line (mapped inputs only)
+size_t next_line_start(Input *in, size_t pos);
+// Both return 1 if a value was read, 0 at the end of the input
+int next_token(Input *in, const char **token, size_t *len);
+int next_int(Input *in, int64_t *x);
+// The next width raw bytes; a partial record at the end is an error
+int next_record(Input *in, size_t width, const char **record);
+void close_input(Input *in);
+
+#endif  // LIBS_INPUT_H_
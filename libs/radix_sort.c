@@ -0,0 +1,172 @@
+// Copyright 2020 Radu-Stefan Minea 314CA
+
+#include "libs/radix_sort.h"
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "libs/utils.h"
+
+#define RADIX_BITS 11
+#define RADIX_BUCKETS (1 << RADIX_BITS)
+#define RADIX_PASSES ((64 + RADIX_BITS - 1) / RADIX_BITS)
+// Fewer values than this per thread aren't worth a thread
+#define MIN_SLICE (1 << 16)
+// Flipping the sign bit orders signed values like unsigned ones
+#define SIGN_BIT (UINT64_C(1) << 63)
+
+enum radix_phase { COUNT_ALL, COUNT, SCATTER };
+
+typedef struct radix_worker {
+  pthread_t thread;
+  int phase;
+  const int64_t *src;
+  int64_t *dst;
+  size_t start, end;  // Slice of src
+  int shift;
+  size_t counts[RADIX_PASSES][RADIX_BUCKETS];
+  size_t offsets[RADIX_BUCKETS];  // Where the next value of a digit goes
+} radix_worker;
+
+static void *radix_work(void *arg);
+static void run_phase(radix_worker *workers, int no_threads, int phase);
+
+static inline unsigned digit(int64_t x, int shift) {
+  return (((uint64_t)x ^ SIGN_BIT) >> shift) & (RADIX_BUCKETS - 1);
+}
+
+// The digits of every pass, in one read of the slice
+static void count_all(radix_worker *w) {
+  memset(w->counts, 0, sizeof(w->counts));
+  for (size_t i = w->start; i < w->end; i++) {
+    uint64_t x = (uint64_t)w->src[i] ^ SIGN_BIT;
+    for (int p = 0; p < RADIX_PASSES; p++) {
+      w->counts[p][(x >> (p * RADIX_BITS)) & (RADIX_BUCKETS - 1)]++;
+    }
+  }
+}
+
+static void count(radix_worker *w) {
+  size_t *counts = w->counts[w->shift / RADIX_BITS];
+
+  memset(counts, 0, RADIX_BUCKETS * sizeof(size_t));
+  for (size_t i = w->start; i < w->end; i++) {
+    counts[digit(w->src[i], w->shift)]++;
+  }
+}
+
+static void scatter(radix_worker *w) {
+  size_t *pos = w->offsets;
+
+  for (size_t i = w->start; i < w->end; i++) {
+    int64_t x = w->src[i];
+    w->dst[pos[digit(x, w->shift)]++] = x;
+  }
+}
+
+static void *radix_work(void *arg) {
+  radix_worker *w = arg;
+
+  switch (w->phase) {
+    case COUNT_ALL:
+      count_all(w);
+      break;
+    case COUNT:
+      count(w);
+      break;
+    case SCATTER:
+      scatter(w);
+      break;
+  }
+  return NULL;
+}
+
+static void run_phase(radix_worker *workers, int no_threads, int phase) {
+  for (int i = 0; i < no_threads; i++) {
+    workers[i].phase = phase;
+  }
+
+  if (no_threads == 1) {
+    radix_work(&workers[0]);
+    return;
+  }
+
+  for (int i = 0; i < no_threads; i++) {
+    if (pthread_create(&workers[i].thread, NULL, radix_work, &workers[i])) {
+      fprintf(stderr, "Couldn't start thread\n");
+      exit(ERROR_STATUS);
+    }
+  }
+  for (int i = 0; i < no_threads; i++) {
+    pthread_join(workers[i].thread, NULL);
+  }
+}
+
+int64_t *radix_sort(int64_t *values, int64_t *tmp, size_t n, int no_threads) {
+  if (no_threads > RADIX_MAX_THREADS) {
+    no_threads = RADIX_MAX_THREADS;
+  }
+  if ((size_t)no_threads > n / MIN_SLICE) {
+    no_threads = n / MIN_SLICE ? n / MIN_SLICE : 1;
+  }
+
+  radix_worker *workers = malloc(no_threads * sizeof(radix_worker));
+  mem_check(workers);
+  for (int i = 0; i < no_threads; i++) {
+    workers[i].start = n / no_threads * i;
+    workers[i].end = i + 1 < no_threads ? n / no_threads * (i + 1) : n;
+    workers[i].src = values;
+  }
+
+  // Passes where every value has the same digit don't move anything
+  run_phase(workers, no_threads, COUNT_ALL);
+  int skip[RADIX_PASSES];
+  for (int p = 0; p < RADIX_PASSES; p++) {
+    skip[p] = 0;
+    for (int d = 0; d < RADIX_BUCKETS && !skip[p]; d++) {
+      size_t total = 0;
+      for (int i = 0; i < no_threads; i++) {
+        total += workers[i].counts[p][d];
+      }
+      skip[p] = total == n;
+    }
+  }
+
+  int64_t *src = values, *dst = tmp;
+  int counted = 1;  // The counts of the slices of src are up to date
+  for (int p = 0; p < RADIX_PASSES; p++) {
+    if (skip[p]) {
+      continue;
+    }
+
+    for (int i = 0; i < no_threads; i++) {
+      workers[i].src = src;
+      workers[i].dst = dst;
+      workers[i].shift = p * RADIX_BITS;
+    }
+    if (!counted) {
+      run_phase(workers, no_threads, COUNT);
+    }
+
+    // Digit by digit, slice by slice
+    size_t offset = 0;
+    for (int d = 0; d < RADIX_BUCKETS; d++) {
+      for (int i = 0; i < no_threads; i++) {
+        workers[i].offsets[d] = offset;
+        offset += workers[i].counts[p][d];
+      }
+    }
+
+    run_phase(workers, no_threads, SCATTER);
+    counted = 0;
+
+    int64_t *aux = src;
+    src = dst;
+    dst = aux;
+  }
+
+  free(workers);
+  return src;
+}
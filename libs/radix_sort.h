@@ -0,0 +1,24 @@
+// Copyright 2020 Radu-Stefan Minea 314CA
+
+#ifndef LIBS_RADIX_SORT_H_
+#define LIBS_RADIX_SORT_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define RADIX_MAX_THREADS 256
+
+/*
+ * LSD radix sort of 64-bit signed integers, 11 bits per pass (6 passes),
+ * split between up to RADIX_MAX_THREADS threads: in every pass, each thread
+ * counts the digits of its slice, and then moves its values to the
+ * positions given by the counts of all the slices before it (so the sort
+ * stays stable). A pass is skipped when all the values have the same digit
+ * there, so values in a small range only take a few passes.
+ */
+
+// Sorts the n values increasingly, with tmp (room for n values) as scratch;
+// returns whichever of values and tmp holds the result
+int64_t *radix_sort(int64_t *values, int64_t *tmp, size_t n, int no_threads);
+
+#endif  // LIBS_RADIX_SORT_H_
@@ -0,0 +1,87 @@
+// Copyright 2020 Radu-Stefan Minea 314CA
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "libs/spill.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "libs/hashing.h"
+#include "libs/utils.h"
+
+#define SPILL_NAME "/hash-spill-XXXXXX"
+// Spill files are written and read in big sequential blocks
+#define SPILL_BUFFER_SIZE (1 << 16)
+
+FILE *open_spill_file(void) {
+  const char *dir = getenv("TMPDIR");
+  if (dir == NULL || dir[0] == '\0') {
+    dir = "/tmp";
+  }
+
+  size_t dir_len = strlen(dir);
+  char *path = malloc(dir_len + sizeof(SPILL_NAME));
+  mem_check(path);
+  memcpy(path, dir, dir_len);
+  memcpy(path + dir_len, SPILL_NAME, sizeof(SPILL_NAME));
+
+  int fd = mkstemp(path);
+  if (fd < 0) {
+    fprintf(stderr, "Couldn't create a spill file in %s\n", dir);
+    exit(ERROR_STATUS);
+  }
+  unlink(path);
+  free(path);
+
+  FILE *f = fdopen(fd, "w+");
+  if (f == NULL) {
+    fprintf(stderr, "Couldn't open a spill file\n");
+    exit(ERROR_STATUS);
+  }
+  setvbuf(f, NULL, _IOFBF, SPILL_BUFFER_SIZE);
+  return f;
+}
+
+/*
+ * Every level mixes the hash again, so the keys of one partition spread
+ * over all the partitions of the next level (even for a 32-bit hash)
+ */
+int spill_partition(uint64_t hash, int level) {
+  return hash_u64(hash + level) >> (64 - SPILL_FANOUT_BITS);
+}
+
+void spill_write(FILE *f, const char *key, uint32_t len, uint64_t count) {
+  if (fwrite(&len, sizeof(len), 1, f) != 1 ||
+      fwrite(&count, sizeof(count), 1, f) != 1 ||
+      fwrite(key, 1, len, f) != len) {
+    fprintf(stderr, "Error writing a spill file\n");
+    exit(ERROR_STATUS);
+  }
+}
+
+int spill_read(FILE *f, char **key, size_t *key_cap, uint32_t *len,
+               uint64_t *count) {
+  if (fread(len, sizeof(*len), 1, f) != 1) {
+    if (ferror(f)) {
+      fprintf(stderr, "Error reading a spill file\n");
+      exit(ERROR_STATUS);
+    }
+    return 0;
+  }
+
+  if (*len + 1 > *key_cap) {
+    *key_cap = *len + 1;
+    *key = realloc(*key, *key_cap);
+    mem_check(*key);
+  }
+
+  if (fread(count, sizeof(*count), 1, f) != 1 ||
+      fread(*key, 1, *len, f) != *len) {
+    fprintf(stderr, "Error reading a spill file\n");
+    exit(ERROR_STATUS);
+  }
+  (*key)[*len] = '\0';
+  return 1;
+}
@@ -0,0 +1,33 @@
+// Copyright 2020 Radu-Stefan Minea 314CA
+
+#ifndef LIBS_SPILL_H_
+#define LIBS_SPILL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/*
+ * Partition files of hash.c's out-of-core mode (--mem-limit). Whenever the
+ * in-memory table is full, every (key, count) it holds is appended to one
+ * of SPILL_FANOUT files, picked by bits of the key's hash; keys are then
+ * only ever in one file, so every file can be counted on its own. A file
+ * is a plain sequence of records: u32 key length, u64 count, key bytes.
+ * Files are deleted as soon as they are created, so they go away with the
+ * process, however it ends.
+ */
+#define SPILL_FANOUT_BITS 4
+#define SPILL_FANOUT (1 << SPILL_FANOUT_BITS)
+// A partition this deep is counted in memory whatever the limit (only keys
+// with the same full hash can still be together there)
+#define SPILL_MAX_LEVEL 8
+
+// Empty file in $TMPDIR (or /tmp)
+FILE *open_spill_file(void);
+int spill_partition(uint64_t hash, int level);
+void spill_write(FILE *f, const char *key, uint32_t len, uint64_t count);
+// Reads the next record into *key (grown as needed); 0 at the end of f
+int spill_read(FILE *f, char **key, size_t *key_cap, uint32_t *len,
+               uint64_t *count);
+
+#endif  // LIBS_SPILL_H_
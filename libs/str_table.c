@@ -0,0 +1,317 @@
+// Copyright 2020 Radu-Stefan Minea 314CA
+
+#include "libs/str_table.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "libs/swiss_table.h"
+#include "libs/utils.h"
+
+// The table doubles before its load factor would exceed
+// MAX_LOAD_NUM / MAX_LOAD_DEN (3/4 for linear probing, 7/8 for swiss)
+#define MAX_LOAD_NUM(engine) ((engine) == SWISS_ENGINE ? 7 : 3)
+#define MAX_LOAD_DEN(engine) ((engine) == SWISS_ENGINE ? 8 : 4)
+
+void init_ht(Hashtable *ht, int hmax, hash_fn hash_function,
+             int (*compare_function)(const void *, const void *, size_t),
+             int engine) {
+  if (ht == NULL) {
+    return;
+  }
+
+  // Swiss engine masks instead of taking the modulo => rounding up to a
+  // power of 2
+  if (engine == SWISS_ENGINE) {
+    int pow2 = GROUP_WIDTH;
+    while (pow2 < hmax) {
+      pow2 <<= 1;
+    }
+    hmax = pow2;
+  }
+
+  ht->engine = engine;
+  ht->size = 0;
+  ht->hmax = hmax;
+  ht->hash_function = hash_function;
+  ht->compare_function = compare_function;
+  init_arena(&ht->keys, ARENA_CHUNK_SIZE);
+
+  ht->buckets = calloc(hmax, sizeof(info));
+  mem_check(ht->buckets);
+  init_counters(&ht->counts, hmax, 1);
+
+  ht->ctrl = NULL;
+  if (engine == SWISS_ENGINE) {
+    swiss_init(ht);
+  }
+}
+
+int compare_function_strings(const void *a, const void *b, size_t len) {
+  return memcmp(a, b, len);
+}
+
+const char *bucket_key(info *bucket) {
+  if (bucket->state == INLINE_KEY) {
+    return bucket->k.inline_key;
+  }
+  return bucket->k.key;
+}
+
+// Same as key_matches: the default wyhash is inlined, not called
+static inline uint64_t key_hash(Hashtable *ht, const void *key,
+                                int key_size_bytes) {
+  if (ht->hash_function == hash_bytes) {
+    return wyhash(key, key_size_bytes);
+  }
+  return ht->hash_function(key, key_size_bytes);
+}
+
+static info *linear_probe(Hashtable *ht, const void *key,
+                          int key_size_bytes, uint64_t full_hash) {
+  unsigned int hash = full_hash % ht->hmax;
+  info *inside_data = &ht->buckets[hash];
+
+  // Linear probing; the key is only compared once hash and length match
+  while (inside_data->state != EMPTY_BUCKET) {
+    if (key_matches(ht, inside_data, key, key_size_bytes, full_hash)) {
+      return inside_data;
+    }
+
+    hash = (hash + 1) % ht->hmax;
+    inside_data = &ht->buckets[hash];
+  }
+
+  return inside_data;
+}
+
+// Array bytes of a table with hmax buckets
+static size_t table_bytes(const Hashtable *ht, int hmax) {
+  size_t bytes = (size_t)hmax * (sizeof(info) + ht->counts.width);
+  if (ht->engine == SWISS_ENGINE) {
+    bytes += hmax + GROUP_WIDTH;
+  }
+  return bytes;
+}
+
+static int needs_resize(const Hashtable *ht) {
+  return (int64_t)(ht->size + 1) * MAX_LOAD_DEN(ht->engine) >
+         (int64_t)ht->hmax * MAX_LOAD_NUM(ht->engine);
+}
+
+size_t ht_memory(const Hashtable *ht) {
+  return table_bytes(ht, ht->hmax) + ht->keys.allocated;
+}
+
+size_t ht_peak_memory(const Hashtable *ht, size_t key_len) {
+  size_t bytes = ht_memory(ht);
+
+  if (needs_resize(ht)) {
+    bytes += table_bytes(ht, 2 * ht->hmax);
+  }
+  // A long key may need a new chunk of the arena
+  if (key_len > SHORT_KEY_LEN) {
+    bytes += key_len + 1 > ht->keys.chunk_size ? key_len + 1
+                                               : ht->keys.chunk_size;
+  }
+  return bytes;
+}
+
+/*
+ * Returns the bucket holding key; if key isn't in the hashtable yet, it's
+ * copied into a new bucket (or into the arena, if it's too long), whose
+ * count is 0
+ */
+info *find_bucket(Hashtable *ht, const void *key, int key_size_bytes) {
+  // Growing before probing, so that an empty bucket always exists
+  if (needs_resize(ht)) {
+    resize_ht(ht, 2 * ht->hmax);
+  }
+
+  uint64_t full_hash = key_hash(ht, key, key_size_bytes);
+  info *inside_data;
+  if (ht->engine == SWISS_ENGINE) {
+    inside_data = swiss_probe(ht, key, key_size_bytes, full_hash);
+  } else {
+    inside_data = linear_probe(ht, key, key_size_bytes, full_hash);
+  }
+
+  if (inside_data->state != EMPTY_BUCKET) {
+    return inside_data;
+  }
+
+  // NEW STRING => copying the key
+  inside_data->hash = full_hash;
+  inside_data->key_len = key_size_bytes;
+  if (key_size_bytes <= SHORT_KEY_LEN) {
+    memcpy(inside_data->k.inline_key, key, key_size_bytes);
+    inside_data->k.inline_key[key_size_bytes] = '\0';
+    inside_data->state = INLINE_KEY;
+  } else {
+    inside_data->k.key = arena_strndup(&ht->keys, key, key_size_bytes);
+    mem_check(inside_data->k.key);
+    inside_data->state = EXTERNAL_KEY;
+  }
+  ht->size++;
+
+  return inside_data;
+}
+
+void put(struct Hashtable *ht, const void *key, int key_size_bytes) {
+  if (ht == NULL) {
+    return;
+  }
+
+  // NEW STRING => count goes from 0 to NEW_STRING_CNT
+  // OLD STRING => updating count
+  info *inside_data = find_bucket(ht, key, key_size_bytes);
+  add_count(ht, inside_data, NEW_STRING_CNT);
+}
+
+uint64_t get_count(Hashtable *ht, info *bucket) {
+  return counters_get(&ht->counts, bucket - ht->buckets);
+}
+
+void add_count(Hashtable *ht, info *bucket, uint64_t n) {
+  counters_add(&ht->counts, bucket - ht->buckets, n);
+}
+
+/*
+ * Returns the hashtable's own copy of key, adding key (with a count of 0)
+ * if needed. The copy lives as long as the hashtable does, even across
+ * resizes, and equal strings always get the same pointer, so interned
+ * strings can be compared with ==.
+ */
+const char *intern(Hashtable *ht, const void *key, int key_size_bytes) {
+  if (ht == NULL) {
+    return NULL;
+  }
+
+  info *inside_data = find_bucket(ht, key, key_size_bytes);
+
+  // Inline keys move along with their bucket => moving it to the arena
+  if (inside_data->state == INLINE_KEY) {
+    char *copy = arena_strndup(&ht->keys, key, key_size_bytes);
+    mem_check(copy);
+    inside_data->k.key = copy;
+    inside_data->state = EXTERNAL_KEY;
+  }
+
+  return inside_data->k.key;
+}
+
+void resize_ht(Hashtable *ht, int new_hmax) {
+  if (ht == NULL) {
+    return;
+  }
+
+  if (ht->engine == SWISS_ENGINE) {
+    swiss_resize(ht, new_hmax);
+    return;
+  }
+
+  info *old_buckets = ht->buckets;
+  Counters old_counts = ht->counts;
+  int old_hmax = ht->hmax;
+
+  ht->hmax = new_hmax;
+  ht->buckets = calloc(new_hmax, sizeof(info));
+  mem_check(ht->buckets);
+  init_counters(&ht->counts, new_hmax, old_counts.width);
+
+  // Moving every entry to its new bucket; the stored hash is reused and
+  // keys in the arena are moved, not copied
+  for (int i = 0; i < old_hmax; i++) {
+    if (old_buckets[i].state == EMPTY_BUCKET) {
+      continue;
+    }
+
+    unsigned int hash = old_buckets[i].hash % new_hmax;
+    while (ht->buckets[hash].state != EMPTY_BUCKET) {
+      hash = (hash + 1) % new_hmax;
+    }
+    ht->buckets[hash] = old_buckets[i];
+    counters_set(&ht->counts, hash, counters_get(&old_counts, i));
+  }
+
+  free(old_buckets);
+  free_counters(&old_counts);
+}
+
+void clear_ht(Hashtable *ht) {
+  if (ht == NULL) {
+    return;
+  }
+
+  memset(ht->buckets, 0, (size_t)ht->hmax * sizeof(info));
+  memset(ht->counts.data, 0, ht->counts.size * ht->counts.width);
+  if (ht->ctrl != NULL) {
+    memset(ht->ctrl, EMPTY_CTRL, ht->hmax + GROUP_WIDTH);
+  }
+  free_arena(&ht->keys);
+  ht->size = 0;
+}
+
+void free_ht(Hashtable *ht) {
+  if (ht == NULL) {
+    return;
+  }
+
+  free_arena(&ht->keys);
+  free(ht->buckets);
+  free_counters(&ht->counts);
+  free(ht->ctrl);
+  free(ht);
+}
+
+static int compare_hashes(const void *a, const void *b) {
+  uint64_t hash_a = *(const uint64_t *)a;
+  uint64_t hash_b = *(const uint64_t *)b;
+
+  return (hash_a > hash_b) - (hash_a < hash_b);
+}
+
+/*
+ * Probe length of a key = buckets (linear) or groups (swiss) a lookup for
+ * it goes through. Collisions = keys whose full hash isn't unique.
+ */
+void probe_stats(Hashtable *ht, double *avg_probes, int *max_probes,
+                 int *collisions) {
+  int64_t total = 0;
+  int cnt = 0;
+  uint64_t *hashes = malloc((ht->size + 1) * sizeof(uint64_t));
+  mem_check(hashes);
+
+  *max_probes = 0;
+  for (int i = 0; i < ht->hmax; i++) {
+    if (ht->buckets[i].state == EMPTY_BUCKET) {
+      continue;
+    }
+
+    int probes;
+    if (ht->engine == SWISS_ENGINE) {
+      probes = swiss_probe_length(ht, i);
+    } else {
+      int home = ht->buckets[i].hash % ht->hmax;
+      probes = (i - home + ht->hmax) % ht->hmax + 1;
+    }
+
+    total += probes;
+    if (probes > *max_probes) {
+      *max_probes = probes;
+    }
+    hashes[cnt++] = ht->buckets[i].hash;
+  }
+  *avg_probes = cnt ? (double)total / cnt : 0;
+
+  qsort(hashes, cnt, sizeof(uint64_t), compare_hashes);
+  *collisions = 0;
+  for (int i = 0; i < cnt; i++) {
+    if ((i > 0 && hashes[i] == hashes[i - 1]) ||
+        (i + 1 < cnt && hashes[i] == hashes[i + 1])) {
+      (*collisions)++;
+    }
+  }
+
+  free(hashes);
+}
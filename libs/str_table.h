@@ -0,0 +1,101 @@
+// Copyright 2020 Radu-Stefan Minea 314CA
+
+#ifndef LIBS_STR_TABLE_H_
+#define LIBS_STR_TABLE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "libs/arena.h"
+#include "libs/counters.h"
+#include "libs/hashing.h"
+
+#define NEW_STRING_CNT 1
+#define INITIAL_HMAX 16
+// Keys this short are kept inside the bucket itself
+#define SHORT_KEY_LEN 15
+
+enum bucket_state { EMPTY_BUCKET, INLINE_KEY, EXTERNAL_KEY };
+
+/*
+ * LINEAR_ENGINE: linear probing, one bucket at a time
+ * SWISS_ENGINE: control bytes probed 16 at a time (see swiss_table.h)
+ */
+enum ht_engine { LINEAR_ENGINE, SWISS_ENGINE };
+
+/*
+ * 32 bytes, so two buckets share a cache line (state sits in the padding
+ * before the 8-byte aligned union). The full hash and the key length are
+ * checked before the key itself, and short keys are compared without
+ * leaving the bucket. Counts are kept apart (see Hashtable).
+ */
+typedef struct info {
+  uint64_t hash;
+  uint32_t key_len;
+  char state;
+  union {
+    char inline_key[SHORT_KEY_LEN + 1];
+    char *key;  // Stored in the arena
+  } k;
+} info;
+
+_Static_assert(sizeof(info) == 32, "info has to stay 32 bytes");
+
+typedef struct Hashtable {
+  info *buckets;
+  uint8_t *ctrl;  // Only used by SWISS_ENGINE
+  Counters counts;  // counts[i] belongs to buckets[i]; widened on overflow
+  Arena keys;  // Every long key lives here, so they are all freed at once
+  int engine;
+  int size;
+  int hmax;  // Always a power of 2 for SWISS_ENGINE
+  hash_fn hash_function;
+  // Only called on keys of the same length
+  int (*compare_function)(const void *, const void *, size_t);
+} Hashtable;
+
+/*
+ * Keys are (pointer, length) pairs and don't need to be NUL-terminated;
+ * the hashtable's own copies always are.
+ */
+void init_ht(Hashtable *ht, int hmax, hash_fn hash_function,
+             int (*compare_function)(const void *, const void *, size_t),
+             int engine);
+const char *bucket_key(info *bucket);
+int compare_function_strings(const void *a, const void *b, size_t len);
+info *find_bucket(Hashtable *ht, const void *key, int key_size_bytes);
+void put(struct Hashtable *ht, const void *key, int key_size_bytes);
+uint64_t get_count(Hashtable *ht, info *bucket);
+void add_count(Hashtable *ht, info *bucket, uint64_t n);
+const char *intern(Hashtable *ht, const void *key, int key_size_bytes);
+void resize_ht(Hashtable *ht, int new_hmax);
+// Removes every key, but keeps the arrays (and hmax) for the next ones
+void clear_ht(Hashtable *ht);
+// Bytes used by the hashtable right now
+size_t ht_memory(const Hashtable *ht);
+// Bytes it would use at its peak if a new key (of at most key_len bytes)
+// came now, counting both arrays while it doubles
+size_t ht_peak_memory(const Hashtable *ht, size_t key_len);
+void free_ht(Hashtable *ht);
+void probe_stats(Hashtable *ht, double *avg_probes, int *max_probes,
+                 int *collisions);
+
+/*
+ * With the default compare_function_strings, memcmp is called directly, so
+ * the compiler can inline it into the probing loops; any other function
+ * still goes through the pointer
+ */
+static inline int key_matches(Hashtable *ht, info *bucket, const void *key,
+                              int key_size_bytes, uint64_t full_hash) {
+  if (bucket->hash != full_hash ||
+      bucket->key_len != (unsigned int)key_size_bytes) {
+    return 0;
+  }
+  if (ht->compare_function == compare_function_strings) {
+    return !memcmp(key, bucket_key(bucket), key_size_bytes);
+  }
+  return !ht->compare_function(key, bucket_key(bucket), key_size_bytes);
+}
+
+#endif  // LIBS_STR_TABLE_H_
@@ -0,0 +1,158 @@
+// Copyright 2020 Radu-Stefan Minea 314CA
+
+#include "libs/swiss_table.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include "libs/utils.h"
+
+#define H2_BITS 7
+// Top bits of the low 32, which every hash function has (djb2 only has
+// those 32); the slot comes from the lowest bits, so the two stay
+// independent up to 2^25 slots
+#define H2_SHIFT (32 - H2_BITS)
+
+static inline uint8_t h2(uint64_t full_hash) {
+  return (full_hash >> H2_SHIFT) & ((1 << H2_BITS) - 1);
+}
+
+// Bit i of the result is set if group[i] == byte
+static inline unsigned int match_byte(const uint8_t *group, uint8_t byte) {
+#ifdef __SSE2__
+  __m128i ctrl = _mm_loadu_si128((const __m128i *)group);
+  __m128i eq = _mm_cmpeq_epi8(ctrl, _mm_set1_epi8((char)byte));
+  return _mm_movemask_epi8(eq);
+#else
+  unsigned int mask = 0;
+  for (int i = 0; i < GROUP_WIDTH; i++) {
+    if (group[i] == byte) {
+      mask |= 1u << i;
+    }
+  }
+  return mask;
+#endif
+}
+
+static inline void set_ctrl(Hashtable *ht, int pos, uint8_t byte) {
+  ht->ctrl[pos] = byte;
+  if (pos < GROUP_WIDTH) {
+    ht->ctrl[ht->hmax + pos] = byte;
+  }
+}
+
+static uint8_t *alloc_ctrl(int hmax) {
+  uint8_t *ctrl = malloc(hmax + GROUP_WIDTH);
+  mem_check(ctrl);
+  memset(ctrl, EMPTY_CTRL, hmax + GROUP_WIDTH);
+  return ctrl;
+}
+
+void swiss_init(Hashtable *ht) {
+  if (ht == NULL) {
+    return;
+  }
+
+  ht->ctrl = alloc_ctrl(ht->hmax);
+}
+
+/*
+ * Returns the bucket holding key or, if there's none, the empty bucket where
+ * key should go (its control byte is already set). Groups are visited in
+ * triangular order, which reaches every group of a power-of-2 table.
+ */
+info *swiss_probe(Hashtable *ht, const void *key, int key_size_bytes,
+                  uint64_t full_hash) {
+  unsigned int mask = ht->hmax - 1;
+  unsigned int pos = full_hash & mask;
+  unsigned int step = 0;
+  uint8_t tag = h2(full_hash);
+
+  while (1) {
+    const uint8_t *group = ht->ctrl + pos;
+
+    // Candidates: buckets whose 7 bits of hash match
+    unsigned int candidates = match_byte(group, tag);
+    while (candidates) {
+      unsigned int i = (pos + __builtin_ctz(candidates)) & mask;
+      if (key_matches(ht, &ht->buckets[i], key, key_size_bytes, full_hash)) {
+        return &ht->buckets[i];
+      }
+      candidates &= candidates - 1;
+    }
+
+    // There are no deletions, so the first empty bucket ends the search
+    unsigned int empty = match_byte(group, EMPTY_CTRL);
+    if (empty) {
+      unsigned int i = (pos + __builtin_ctz(empty)) & mask;
+      set_ctrl(ht, i, tag);
+      return &ht->buckets[i];
+    }
+
+    step += GROUP_WIDTH;
+    pos = (pos + step) & mask;
+  }
+}
+
+// Number of groups a lookup visits before reaching bucket pos
+int swiss_probe_length(Hashtable *ht, int pos) {
+  unsigned int mask = ht->hmax - 1;
+  unsigned int group_pos = ht->buckets[pos].hash & mask;
+  unsigned int step = 0;
+  int groups = 1;
+
+  while (((pos - group_pos) & mask) >= GROUP_WIDTH) {
+    step += GROUP_WIDTH;
+    group_pos = (group_pos + step) & mask;
+    groups++;
+  }
+
+  return groups;
+}
+
+void swiss_resize(Hashtable *ht, int new_hmax) {
+  if (ht == NULL) {
+    return;
+  }
+
+  info *old_buckets = ht->buckets;
+  Counters old_counts = ht->counts;
+  uint8_t *old_ctrl = ht->ctrl;
+  int old_hmax = ht->hmax;
+
+  ht->hmax = new_hmax;
+  ht->buckets = calloc(new_hmax, sizeof(info));
+  mem_check(ht->buckets);
+  init_counters(&ht->counts, new_hmax, old_counts.width);
+  ht->ctrl = alloc_ctrl(new_hmax);
+
+  // Keys are all distinct => only looking for empty buckets
+  unsigned int mask = new_hmax - 1;
+  for (int i = 0; i < old_hmax; i++) {
+    if (old_ctrl[i] == EMPTY_CTRL) {
+      continue;
+    }
+
+    uint64_t hash = old_buckets[i].hash;
+    unsigned int pos = hash & mask;
+    unsigned int step = 0;
+    unsigned int empty;
+    while (!(empty = match_byte(ht->ctrl + pos, EMPTY_CTRL))) {
+      step += GROUP_WIDTH;
+      pos = (pos + step) & mask;
+    }
+
+    unsigned int new_pos = (pos + __builtin_ctz(empty)) & mask;
+    set_ctrl(ht, new_pos, h2(hash));
+    ht->buckets[new_pos] = old_buckets[i];
+    counters_set(&ht->counts, new_pos, counters_get(&old_counts, i));
+  }
+
+  free(old_buckets);
+  free_counters(&old_counts);
+  free(old_ctrl);
+}
@@ -0,0 +1,25 @@
+// Copyright 2020 Radu-Stefan Minea 314CA
+
+#ifndef LIBS_SWISS_TABLE_H_
+#define LIBS_SWISS_TABLE_H_
+
+#include "libs/str_table.h"
+
+/*
+ * Swiss-table style engine for the Hashtable: next to the buckets there is
+ * one control byte per bucket, either EMPTY_CTRL or 7 bits (25..31) of the
+ * bucket's hash. A whole group of GROUP_WIDTH control bytes is compared
+ * with one SSE2 instruction, and only buckets whose 7 bits match are looked
+ * at. The first GROUP_WIDTH control bytes are mirrored after the last one,
+ * so a group never has to wrap around.
+ */
+#define GROUP_WIDTH 16
+#define EMPTY_CTRL 0x80
+
+void swiss_init(Hashtable *ht);
+info *swiss_probe(Hashtable *ht, const void *key, int key_size_bytes,
+                  uint64_t full_hash);
+int swiss_probe_length(Hashtable *ht, int pos);
+void swiss_resize(Hashtable *ht, int new_hmax);
+
+#endif  // LIBS_SWISS_TABLE_H_
@@ -0,0 +1,189 @@
+// Copyright 2020 Radu-Stefan Minea 314CA
+
+#include "libs/top_k.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "libs/utils.h"
+
+void init_top_k(TopK *top, uint32_t k, hash_fn hash_function,
+                uint32_t cms_width, uint32_t cms_depth) {
+  if (top == NULL) {
+    return;
+  }
+
+  top->k = k;
+  top->size = 0;
+  top->heap = malloc((size_t)k * sizeof(top_entry));
+  mem_check(top->heap);
+
+  // At most half full, so probe sequences stay short
+  uint32_t slots = 4;
+  while (slots < 2 * k) {
+    slots <<= 1;
+  }
+  top->index = calloc(slots, sizeof(uint32_t));
+  mem_check(top->index);
+  top->index_mask = slots - 1;
+
+  top->hash_function = hash_function;
+  init_count_min(&top->cms, cms_width, cms_depth);
+}
+
+// Moves an entry to a new heap position, keeping the index in sync
+static void place(TopK *top, uint32_t pos, top_entry *e) {
+  top->heap[pos] = *e;
+  top->index[e->slot] = pos + 1;
+}
+
+static void sift_up(TopK *top, uint32_t pos) {
+  top_entry e = top->heap[pos];
+
+  while (pos > 0) {
+    uint32_t parent = (pos - 1) / 2;
+    if (top->heap[parent].count <= e.count) {
+      break;
+    }
+    place(top, pos, &top->heap[parent]);
+    pos = parent;
+  }
+  place(top, pos, &e);
+}
+
+static void sift_down(TopK *top, uint32_t pos) {
+  top_entry e = top->heap[pos];
+
+  for (;;) {
+    uint32_t child = 2 * pos + 1;
+    if (child >= top->size) {
+      break;
+    }
+    if (child + 1 < top->size &&
+        top->heap[child + 1].count < top->heap[child].count) {
+      child++;
+    }
+    if (e.count <= top->heap[child].count) {
+      break;
+    }
+    place(top, pos, &top->heap[child]);
+    pos = child;
+  }
+  place(top, pos, &e);
+}
+
+// Index slot of the key, or of the empty slot where it would go
+static uint32_t find_slot(const TopK *top, const char *key, size_t len,
+                          uint64_t hash) {
+  uint32_t slot = hash & top->index_mask;
+
+  while (top->index[slot]) {
+    const top_entry *e = &top->heap[top->index[slot] - 1];
+    if (e->hash == hash && e->len == len && !memcmp(e->key, key, len)) {
+      break;
+    }
+    slot = (slot + 1) & top->index_mask;
+  }
+  return slot;
+}
+
+// Empties a slot, shifting back the entries that probed past it
+static void remove_slot(TopK *top, uint32_t slot) {
+  uint32_t next = (slot + 1) & top->index_mask;
+
+  while (top->index[next]) {
+    top_entry *e = &top->heap[top->index[next] - 1];
+    uint32_t home = e->hash & top->index_mask;
+
+    // Can the entry move back to slot (is slot between home and next)?
+    if (((next - home) & top->index_mask) >=
+        ((next - slot) & top->index_mask)) {
+      top->index[slot] = top->index[next];
+      e->slot = slot;
+      slot = next;
+    }
+    next = (next + 1) & top->index_mask;
+  }
+  top->index[slot] = 0;
+}
+
+static void copy_key(top_entry *e, const char *key, size_t len) {
+  e->key = malloc(len + 1);
+  mem_check(e->key);
+  memcpy(e->key, key, len);
+  e->key[len] = '\0';
+  e->len = len;
+}
+
+void top_k_add(TopK *top, const char *key, size_t len) {
+  if (top->k == 0) {
+    return;
+  }
+
+  uint64_t hash = top->hash_function(key, len);
+  uint64_t count = count_min_add(&top->cms, hash, 1);
+  uint32_t slot = find_slot(top, key, len, hash);
+
+  // Already kept => only its count grows, so it can only sink
+  if (top->index[slot]) {
+    uint32_t pos = top->index[slot] - 1;
+    top->heap[pos].count = count;
+    sift_down(top, pos);
+    return;
+  }
+
+  top_entry e;
+  e.hash = hash;
+  e.count = count;
+
+  if (top->size < top->k) {
+    copy_key(&e, key, len);
+    e.slot = slot;
+    top->index[slot] = top->size + 1;
+    top->heap[top->size++] = e;
+    sift_up(top, top->size - 1);
+    return;
+  }
+
+  // Full => the new key replaces the weakest one, if it beats it
+  if (count <= top->heap[0].count) {
+    return;
+  }
+
+  free(top->heap[0].key);
+  remove_slot(top, top->heap[0].slot);
+  slot = find_slot(top, key, len, hash);
+  copy_key(&e, key, len);
+  e.slot = slot;
+  top->index[slot] = 1;
+  top->heap[0] = e;
+  sift_down(top, 0);
+}
+
+static int compare_entries(const void *a, const void *b) {
+  const top_entry *x = a;
+  const top_entry *y = b;
+
+  if (x->count != y->count) {
+    return x->count < y->count ? 1 : -1;
+  }
+  return strcmp(x->key, y->key);
+}
+
+const top_entry *top_k_sorted(TopK *top) {
+  qsort(top->heap, top->size, sizeof(top_entry), compare_entries);
+  return top->heap;
+}
+
+void free_top_k(TopK *top) {
+  if (top == NULL) {
+    return;
+  }
+
+  for (uint32_t i = 0; i < top->size; i++) {
+    free(top->heap[i].key);
+  }
+  free(top->heap);
+  free(top->index);
+  free_count_min(&top->cms);
+}
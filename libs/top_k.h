@@ -0,0 +1,46 @@
+// Copyright 2020 Radu-Stefan Minea 314CA
+
+#ifndef LIBS_TOP_K_H_
+#define LIBS_TOP_K_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "libs/count_min.h"
+#include "libs/hashing.h"
+
+/*
+ * The k keys with the highest estimates seen so far, in a min-heap, so the
+ * weakest one is at the root and is the one to go when a key with a bigger
+ * estimate comes. Estimates come from a Count-Min Sketch, so memory stays
+ * O(k + sketch size) no matter how many distinct keys the input has.
+ * A small open-addressed index (hash => heap position) finds the keys that
+ * are already in the heap.
+ */
+typedef struct top_entry {
+  char *key;  // Own copy, NUL-terminated
+  size_t len;
+  uint64_t hash;
+  uint64_t count;
+  uint32_t slot;  // Position in the index
+} top_entry;
+
+typedef struct TopK {
+  uint32_t k;
+  uint32_t size;
+  top_entry *heap;
+  uint32_t *index;  // Heap position + 1, 0 = empty
+  uint32_t index_mask;
+  hash_fn hash_function;
+  CountMin cms;
+} TopK;
+
+void init_top_k(TopK *top, uint32_t k, hash_fn hash_function,
+                uint32_t cms_width, uint32_t cms_depth);
+void top_k_add(TopK *top, const char *key, size_t len);
+// Sorts the kept keys by count (descending, ties by key) and returns them;
+// the heap is gone after that, so it comes after the last top_k_add
+const top_entry *top_k_sorted(TopK *top);
+void free_top_k(TopK *top);
+
+#endif  // LIBS_TOP_K_H_
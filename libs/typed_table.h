@@ -0,0 +1,158 @@
+// Copyright 2020 Radu-Stefan Minea 314CA
+
+#ifndef LIBS_TYPED_TABLE_H_
+#define LIBS_TYPED_TABLE_H_
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "libs/arena.h"
+#include "libs/counters.h"
+#include "libs/hashing.h"
+#include "libs/utils.h"
+
+/*
+ * Count tables specialized for one key type, generated at compile time:
+ * DEFINE_TYPED_TABLE(Name, prefix, key_t, HASH, EQUAL, STORE) makes a type
+ * Name (open addressing, linear probing, power-of-2 capacity, doubles past
+ * load 3/4) and static inline functions prefix_init, prefix_add,
+ * prefix_get, prefix_full and prefix_free. HASH(key, seed) gives the 64-bit
+ * hash, EQUAL(a, b) compares two keys and STORE(arena, key) gives the copy
+ * the table keeps, so hashing and comparing are inlined into the probe loop
+ * instead of being called through pointers on void * keys. Keys are stored
+ * by value. Counts are Counters (1 byte each until one would overflow); a
+ * slot is free while its count is 0, so counts added must be at least 1.
+ *
+ * Instances: I32Table (int32_t keys), I64Table (int64_t keys, freq_map's
+ * FREQ_HASH mode) and StrKeyTable (str_key: bytes + length, not
+ * NUL-terminated).
+ */
+#define TYPED_TABLE_MIN_CAP 16
+
+#define DEFINE_TYPED_TABLE(Name, prefix, key_t, HASH, EQUAL, STORE)          \
+  typedef struct Name {                                                      \
+    key_t *keys;                                                             \
+    Counters counts; /* Adaptive width, like freq's counters */              \
+    size_t size;                                                             \
+    size_t cap;                                                              \
+    Arena arena; /* Key copies that don't fit in key_t, if any */            \
+    uint64_t seed; /* table_seed(), for HASH */                              \
+  } Name;                                                                    \
+                                                                             \
+  static inline void prefix##_alloc(Name *t, size_t cap, int width) {        \
+    t->size = 0;                                                             \
+    t->cap = cap;                                                            \
+    t->keys = malloc(cap * sizeof(key_t));                                   \
+    mem_check(t->keys);                                                      \
+    init_counters(&t->counts, cap, width);                                   \
+  }                                                                          \
+                                                                             \
+  static inline void prefix##_init(Name *t, size_t cap) {                    \
+    size_t pow2 = TYPED_TABLE_MIN_CAP;                                       \
+    while (pow2 < cap) {                                                     \
+      pow2 <<= 1;                                                            \
+    }                                                                        \
+    prefix##_alloc(t, pow2, 1);                                              \
+    init_arena(&t->arena, ARENA_CHUNK_SIZE);                                 \
+    t->seed = table_seed();                                                  \
+  }                                                                          \
+                                                                             \
+  /* Slot holding key, or the free slot where it should go */                \
+  static inline size_t prefix##_slot(const Name *t, key_t key) {             \
+    size_t mask = t->cap - 1;                                                \
+    size_t pos = HASH(key, t->seed) & mask;                                  \
+    while (counters_get(&t->counts, pos) && !EQUAL(t->keys[pos], key)) {     \
+      pos = (pos + 1) & mask;                                                \
+    }                                                                        \
+    return pos;                                                              \
+  }                                                                          \
+                                                                             \
+  /* Stored keys are moved, not copied again */                              \
+  static inline void prefix##_grow(Name *t) {                                \
+    Name old = *t;                                                           \
+    prefix##_alloc(t, 2 * old.cap, old.counts.width);                        \
+    for (size_t i = 0; i < old.cap; i++) {                                   \
+      uint64_t cnt = counters_get(&old.counts, i);                           \
+      if (cnt) {                                                             \
+        size_t pos = prefix##_slot(t, old.keys[i]);                          \
+        t->keys[pos] = old.keys[i];                                          \
+        counters_set(&t->counts, pos, cnt);                                  \
+        t->size++;                                                           \
+      }                                                                      \
+    }                                                                        \
+    free(old.keys);                                                          \
+    free_counters(&old.counts);                                              \
+  }                                                                          \
+                                                                             \
+  /* A new key would make the table grow */                                  \
+  static inline int prefix##_full(const Name *t) {                           \
+    return 4 * (t->size + 1) > 3 * t->cap;                                   \
+  }                                                                          \
+                                                                             \
+  /* Adds n (>= 1) to the count of key */                                    \
+  static inline void prefix##_add(Name *t, key_t key, uint64_t n) {          \
+    size_t pos = prefix##_slot(t, key);                                      \
+    if (!counters_get(&t->counts, pos)) {                                    \
+      if (prefix##_full(t)) {                                                \
+        prefix##_grow(t);                                                    \
+        pos = prefix##_slot(t, key);                                         \
+      }                                                                      \
+      t->keys[pos] = STORE(&t->arena, key);                                  \
+      t->size++;                                                             \
+    }                                                                        \
+    counters_add(&t->counts, pos, n);                                        \
+  }                                                                          \
+                                                                             \
+  /* 0 if key isn't in the table */                                          \
+  static inline uint64_t prefix##_get(const Name *t, key_t key) {            \
+    return counters_get(&t->counts, prefix##_slot(t, key));                  \
+  }                                                                          \
+                                                                             \
+  static inline void prefix##_free(Name *t) {                                \
+    free(t->keys);                                                           \
+    free_counters(&t->counts);                                               \
+    free_arena(&t->arena);                                                   \
+  }
+
+// Ints: stored as they are, hashed with hash_u64 (seeded, see table_seed)
+#define TYPED_INT_HASH(key, seed) hash_u64((uint64_t)(key) ^ (seed))
+#define TYPED_INT_EQUAL(a, b) ((a) == (b))
+#define TYPED_INT_STORE(arena, key) (key)
+
+/*
+ * A string key with its length and its hash, computed once (str_key_of)
+ * and compared before the length and the bytes
+ */
+typedef struct str_key {
+  const char *data;
+  uint64_t hash;
+  uint32_t len;
+} str_key;
+
+static inline str_key str_key_of(const char *data, size_t len) {
+  str_key key = { data, wyhash(data, len), (uint32_t)len };
+  return key;
+}
+
+static inline int str_key_equal(str_key a, str_key b) {
+  return a.hash == b.hash && a.len == b.len && !memcmp(a.data, b.data, a.len);
+}
+
+// The table's copy goes to its arena (NUL-terminated, for printing)
+static inline str_key str_key_store(Arena *arena, str_key key) {
+  key.data = arena_strndup(arena, key.data, key.len);
+  mem_check((void *)key.data);
+  return key;
+}
+
+#define TYPED_STR_HASH(key, seed) ((key).hash)
+
+DEFINE_TYPED_TABLE(I32Table, i32_table, int32_t, TYPED_INT_HASH,
+                   TYPED_INT_EQUAL, TYPED_INT_STORE)
+DEFINE_TYPED_TABLE(I64Table, i64_table, int64_t, TYPED_INT_HASH,
+                   TYPED_INT_EQUAL, TYPED_INT_STORE)
+DEFINE_TYPED_TABLE(StrKeyTable, str_key_table, str_key, TYPED_STR_HASH,
+                   str_key_equal, str_key_store)
+
+#endif  // LIBS_TYPED_TABLE_H_
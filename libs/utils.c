@@ -0,0 +1,13 @@
+// Copyright 2020 Radu-Stefan Minea 314CA
+
+#include "libs/utils.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+void mem_check(void *p) {
+  if (p == NULL) {
+    fprintf(stderr, "Error allocating memory\n");
+    exit(ERROR_STATUS);
+  }
+}
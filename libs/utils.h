@@ -0,0 +1,11 @@
+// Copyright 2020 Radu-Stefan Minea 314CA
+
+#ifndef LIBS_UTILS_H_
+#define LIBS_UTILS_H_
+
+#define ERROR_STATUS -1
+
+// Exits with ERROR_STATUS if an allocation returned NULL
+void mem_check(void *p);
+
+#endif  // LIBS_UTILS_H_
@@ -0,0 +1,109 @@
+// Copyright 2020 Radu-Stefan Minea 314CA
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "libs/writer.h"
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "libs/utils.h"
+
+// "00" "01" ... "99", so digits are produced two at a time
+static const char digit_pairs[] =
+  "00010203040506070809101112131415161718192021222324252627282930313233343536"
+  "37383940414243444546474849505152535455565758596061626364656667686970717273"
+  "7475767778798081828384858687888990919293949596979899";
+
+Writer *open_writer(int fd) {
+  Writer *w = malloc(sizeof(Writer));
+  mem_check(w);
+  w->buffer = malloc(WRITER_BLOCK_SIZE);
+  mem_check(w->buffer);
+  w->fd = fd;
+  w->len = 0;
+  return w;
+}
+
+void flush_writer(Writer *w) {
+  size_t done = 0;
+
+  while (done < w->len) {
+    ssize_t cnt = write(w->fd, w->buffer + done, w->len - done);
+    if (cnt < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      fprintf(stderr, "Error writing output\n");
+      exit(ERROR_STATUS);
+    }
+    done += cnt;
+  }
+
+  w->len = 0;
+}
+
+void write_bytes(Writer *w, const char *s, size_t len) {
+  // Bigger than a block => no point in copying it
+  if (len >= WRITER_BLOCK_SIZE) {
+    flush_writer(w);
+    Writer direct = { w->fd, len, (char *)s };
+    flush_writer(&direct);
+    return;
+  }
+
+  if (w->len + len > WRITER_BLOCK_SIZE) {
+    flush_writer(w);
+  }
+  memcpy(w->buffer + w->len, s, len);
+  w->len += len;
+}
+
+void write_u64(Writer *w, uint64_t x) {
+  if (w->len + MAX_INT_TEXT > WRITER_BLOCK_SIZE) {
+    flush_writer(w);
+  }
+
+  // Filling a scratch buffer from the end, then copying the digits out
+  char text[MAX_INT_TEXT];
+  char *p = text + MAX_INT_TEXT;
+
+  while (x >= 100) {
+    p -= 2;
+    memcpy(p, digit_pairs + 2 * (x % 100), 2);
+    x /= 100;
+  }
+  if (x >= 10) {
+    p -= 2;
+    memcpy(p, digit_pairs + 2 * x, 2);
+  } else {
+    *--p = '0' + x;
+  }
+
+  size_t len = text + MAX_INT_TEXT - p;
+  memcpy(w->buffer + w->len, p, len);
+  w->len += len;
+}
+
+void write_i64(Writer *w, int64_t x) {
+  if (x < 0) {
+    write_char(w, '-');
+    // (Unsigned negation, so INT64_MIN works too)
+    write_u64(w, -(uint64_t)x);
+    return;
+  }
+  write_u64(w, x);
+}
+
+void close_writer(Writer *w) {
+  if (w == NULL) {
+    return;
+  }
+
+  flush_writer(w);
+  free(w->buffer);
+  free(w);
+}
@@ -0,0 +1,39 @@
+// Copyright 2020 Radu-Stefan Minea 314CA
+
+#ifndef LIBS_WRITER_H_
+#define LIBS_WRITER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define WRITER_BLOCK_SIZE (1 << 20)
+// Longest text of a 64-bit integer: sign + 20 digits
+#define MAX_INT_TEXT 21
+
+/*
+ * Buffered output straight to a file descriptor: text is formatted into a
+ * block of WRITER_BLOCK_SIZE bytes and handed to the kernel with a single
+ * write() once the block is full, instead of one stdio call per value.
+ */
+typedef struct Writer {
+  int fd;
+  size_t len;
+  char *buffer;
+} Writer;
+
+Writer *open_writer(int fd);
+void flush_writer(Writer *w);
+void write_bytes(Writer *w, const char *s, size_t len);
+void write_u64(Writer *w, uint64_t x);
+void write_i64(Writer *w, int64_t x);
+// Flushes whatever is left
+void close_writer(Writer *w);
+
+static inline void write_char(Writer *w, char c) {
+  if (w->len == WRITER_BLOCK_SIZE) {
+    flush_writer(w);
+  }
+  w->buffer[w->len++] = c;
+}
+
+#endif  // LIBS_WRITER_H_
@@ -0,0 +1,179 @@
+// Copyright 2020 Radu-Stefan Minea 314CA
+
+/*
+ * Checks the lab Hashtable (libs/Hashtable_lab.c) across several doublings:
+ * put/get/has_key/remove while a rehash is still moving buckets, updates
+ * of keys that may sit in either array, and reuse of removed entries by
+ * the pool. Prints what failed and exits with ERROR_STATUS, or prints OK.
+ *
+ * Usage: tests_lab/lab_test (make lab_test builds and runs it)
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "libs/Hashtable_lab.h"
+#include "libs/utils.h"
+
+#define KEYS 20000
+// Below this many keys, every key is checked at every step of a rehash
+#define FULL_CHECK_KEYS 2048
+#define POOL_KEYS (3 * HT_POOL_BLOCK)
+#define STRING_KEYS 3000
+#define KEY_TEXT_LEN 16
+
+static int failures;
+
+#define VERIFY(cond)                                                        \
+  do {                                                                     \
+    if (!(cond)) {                                                         \
+      fprintf(stderr, "%s:%d: failed: %s\n", __FILE__, __LINE__, #cond);   \
+      failures++;                                                          \
+    }                                                                      \
+  } while (0)
+
+static int values[KEYS];
+static char removed[KEYS];
+
+static int count_blocks(struct Hashtable *ht) {
+  int blocks = 0;
+  for (struct ht_block *b = ht->blocks; b != NULL; b = b->next) {
+    blocks++;
+  }
+  return blocks;
+}
+
+// Every key in [0, n): its value if it's still there, NULL otherwise
+static void check_all(struct Hashtable *ht, int n) {
+  for (int key = 0; key < n; key++) {
+    void *expected = removed[key] ? NULL : &values[key];
+    VERIFY(get(ht, &key) == expected);
+    VERIFY(has_key(ht, &key) == !removed[key]);
+  }
+}
+
+static void test_int_keys(void) {
+  struct Hashtable *ht = malloc(sizeof(struct Hashtable));
+  mem_check(ht);
+  init_ht(ht, 1, hash_function_int, compare_function_ints);
+
+  int size = 0, growths = 0, steps_during_rehash = 0;
+  int removes_during_rehash = 0, updates_during_rehash = 0;
+  int last_hmax = get_ht_hmax(ht);
+
+  for (int key = 0; key < KEYS; key++) {
+    values[key] = key;
+    put(ht, &key, sizeof(int), &values[key]);
+    size++;
+
+    if (get_ht_hmax(ht) != last_hmax) {
+      VERIFY(get_ht_hmax(ht) == 2 * last_hmax);
+      last_hmax = get_ht_hmax(ht);
+      growths++;
+    }
+
+    if (ht->old_buckets != NULL) {
+      steps_during_rehash++;
+
+      // An existing key, updated where it is now (old or new array)
+      int old_key = key / 2;
+      if (!removed[old_key]) {
+        int other = -1;
+        put(ht, &old_key, sizeof(int), &other);
+        VERIFY(get(ht, &old_key) == &other);
+        put(ht, &old_key, sizeof(int), &values[old_key]);
+        updates_during_rehash++;
+      }
+
+      // Every third key goes away again, half-way through the migration
+      if (key % 3 == 0) {
+        remove_ht_entry(ht, &key);
+        removed[key] = 1;
+        size--;
+        removes_during_rehash++;
+      }
+
+      if (key < FULL_CHECK_KEYS) {
+        check_all(ht, key + 1);
+      }
+    }
+
+    VERIFY(get_ht_size(ht) == size);
+  }
+
+  check_all(ht, KEYS);
+  VERIFY(growths >= 10);
+  VERIFY(steps_during_rehash > 0);
+  VERIFY(removes_during_rehash > 0);
+  VERIFY(updates_during_rehash > 0);
+
+  // Removing a key that isn't there changes nothing
+  int missing = KEYS;
+  remove_ht_entry(ht, &missing);
+  VERIFY(get_ht_size(ht) == size);
+
+  // Removed entries are reused before any new block is allocated
+  while (ht->old_buckets != NULL) {
+    get(ht, &missing);
+  }
+  int blocks = count_blocks(ht);
+  for (int key = 1; key <= POOL_KEYS; key++) {
+    if (!removed[key]) {
+      remove_ht_entry(ht, &key);
+      removed[key] = 1;
+      size--;
+    }
+  }
+  for (int key = 1; key <= POOL_KEYS; key++) {
+    if (removed[key]) {
+      put(ht, &key, sizeof(int), &values[key]);
+      removed[key] = 0;
+      size++;
+    }
+  }
+  VERIFY(count_blocks(ht) == blocks);
+  VERIFY(get_ht_size(ht) == size);
+  check_all(ht, KEYS);
+
+  free_ht(ht);
+}
+
+static void test_string_keys(void) {
+  static char keys[STRING_KEYS][KEY_TEXT_LEN];
+  struct Hashtable *ht = malloc(sizeof(struct Hashtable));
+  mem_check(ht);
+  init_ht(ht, 2, hash_function_string, compare_function_strings);
+
+  for (int i = 0; i < STRING_KEYS; i++) {
+    snprintf(keys[i], KEY_TEXT_LEN, "key%d", i);
+    put(ht, keys[i], strlen(keys[i]) + 1, keys[i]);
+  }
+  // The table keeps its own copies of the keys
+  char key[KEY_TEXT_LEN];
+  for (int i = 0; i < STRING_KEYS; i++) {
+    snprintf(key, KEY_TEXT_LEN, "key%d", i);
+    VERIFY(get(ht, key) == keys[i]);
+    if (i % 2) {
+      remove_ht_entry(ht, key);
+    }
+  }
+  for (int i = 0; i < STRING_KEYS; i++) {
+    VERIFY(has_key(ht, keys[i]) == !(i % 2));
+  }
+  VERIFY(get_ht_size(ht) == STRING_KEYS / 2);
+
+  free_ht(ht);
+}
+
+int main(void) {
+  test_int_keys();
+  test_string_keys();
+
+  if (failures) {
+    fprintf(stderr, "lab_test: %d checks failed\n", failures);
+    exit(ERROR_STATUS);
+  }
+  printf("lab_test: OK\n");
+  return 0;
+}
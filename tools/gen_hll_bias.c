@@ -0,0 +1,118 @@
+// Copyright 2020 Radu-Stefan Minea 314CA
+
+/*
+ * Generates libs/hll_bias.c: for every precision, inserts random 64-bit
+ * hashes into plain byte registers, records the raw estimate at
+ * HLL_BIAS_POINTS cardinalities up to 6 * 2^p and prints its average and
+ * bias over many runs.
+ *
+ * Usage: make hll_bias (or tools/gen_hll_bias > libs/hll_bias.c)
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "libs/hll_bias.h"
+#include "libs/hll_estimate.h"
+#include "libs/hll_sketch.h"
+#include "libs/utils.h"
+
+// Every precision gets about this many insertions in total
+#define WORK_PER_PRECISION (1 << 25)
+#define MIN_RUNS 32
+#define VALUES_PER_LINE 4
+
+/*
+ * Credits: splitmix64, Sebastiano Vigna
+ */
+static uint64_t next_random(uint64_t *state) {
+  uint64_t z = (*state += 0x9e3779b97f4a7c15ull);
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+  return z ^ (z >> 31);
+}
+
+static uint64_t point_cardinality(int precision, int j) {
+  uint64_t m = (uint64_t)1 << precision;
+  return ((j + 1) * 6 * m + HLL_BIAS_POINTS - 1) / HLL_BIAS_POINTS;
+}
+
+static void simulate(int precision, double *raw, double *bias) {
+  uint64_t m = (uint64_t)1 << precision;
+  uint64_t last = point_cardinality(precision, HLL_BIAS_POINTS - 1);
+  int runs = WORK_PER_PRECISION / last;
+  uint64_t state = precision;
+
+  if (runs < MIN_RUNS) {
+    runs = MIN_RUNS;
+  }
+
+  uint8_t *registers = malloc(m);
+  mem_check(registers);
+  memset(raw, 0, HLL_BIAS_POINTS * sizeof(double));
+
+  for (int run = 0; run < runs; run++) {
+    memset(registers, 0, m);
+    // sum(2^-register), kept up to date on every change
+    double sum = m;
+    int j = 0;
+
+    for (uint64_t n = 1; n <= last; n++) {
+      uint64_t hash = next_random(&state);
+      uint32_t index = hash >> (64 - precision);
+      uint64_t rest = (hash << precision) |
+                      ((uint64_t)1 << (precision - 1));
+      int rank = __builtin_clzll(rest) + 1;
+
+      if (registers[index] < rank) {
+        sum += ldexp(1, -rank) - ldexp(1, -registers[index]);
+        registers[index] = rank;
+      }
+
+      while (j < HLL_BIAS_POINTS && point_cardinality(precision, j) == n) {
+        raw[j++] += hll_alpha(m) * m * m / sum;
+      }
+    }
+  }
+
+  for (int j = 0; j < HLL_BIAS_POINTS; j++) {
+    raw[j] /= runs;
+    bias[j] = raw[j] - point_cardinality(precision, j);
+  }
+
+  free(registers);
+}
+
+static void print_table(const char *name,
+                        double table[HLL_PRECISIONS][HLL_BIAS_POINTS]) {
+  printf("\nconst double %s[HLL_PRECISIONS][HLL_BIAS_POINTS] = {\n", name);
+  for (int p = 0; p < HLL_PRECISIONS; p++) {
+    printf("  {  // p = %d\n", p + HLL_MIN_PRECISION);
+    for (int j = 0; j < HLL_BIAS_POINTS; j++) {
+      printf("%s%.6g,", j % VALUES_PER_LINE ? " " : "    ", table[p][j]);
+      if (j % VALUES_PER_LINE == VALUES_PER_LINE - 1) {
+        printf("\n");
+      }
+    }
+    printf("  },\n");
+  }
+  printf("};\n");
+}
+
+int main() {
+  static double raw[HLL_PRECISIONS][HLL_BIAS_POINTS];
+  static double bias[HLL_PRECISIONS][HLL_BIAS_POINTS];
+
+  for (int p = HLL_MIN_PRECISION; p <= HLL_MAX_PRECISION; p++) {
+    simulate(p, raw[p - HLL_MIN_PRECISION], bias[p - HLL_MIN_PRECISION]);
+  }
+
+  printf("// Copyright 2020 Radu-Stefan Minea 314CA\n\n");
+  printf("// Generated by tools/gen_hll_bias.c (make hll_bias)\n\n");
+  printf("#include \"libs/hll_bias.h\"\n");
+  print_table("hll_bias_raw", raw);
+  print_table("hll_bias_value", bias);
+  return 0;
+}